@@ -0,0 +1,110 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+// Compares the emission cost of ObserverList and boost::signals2::signal with
+// many observers connected, like a popular attribute with many subscriptions.
+// Also measures the EmissionSequencer overhead added by event attributes, with
+// a single producer and with concurrent producers.
+//
+// Usage: bench_observers [observers] [emissions] [producers]
+
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/signals2.hpp>
+
+#include <graphql_vss_server_libs/support/observers.hpp>
+
+template <typename Fn>
+static double measureNanosecondsPerEmission(size_t emissions, Fn&& emit)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < emissions; i++)
+        emit(static_cast<int>(i));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / emissions;
+}
+
+// Same steps as the event attributes: take a ticket with the producer lock
+// held, release it and emit in order
+static double measureSequencedNanosecondsPerEmission(size_t emissions, size_t producers,
+    SpinLock& lock, EmissionSequencer& sequencer, ObserverList<void(const int&)>& observerList)
+{
+    auto produce = [&](size_t count) {
+        for (size_t i = 0; i < count; i++)
+        {
+            std::unique_lock<SpinLock> guard(lock);
+            auto ticket = sequencer.ticket();
+            guard.unlock();
+            sequencer.emit(ticket, [&observerList, i]() { observerList(static_cast<int>(i)); });
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; i++)
+        threads.emplace_back(produce, emissions / producers);
+    for (auto& thread : threads)
+        thread.join();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count()
+        / (emissions / producers * producers);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t observers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    size_t emissions = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000;
+    size_t producers = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 4;
+    if (producers == 0 || producers > emissions)
+        producers = 1;
+    volatile int sink = 0;
+
+    ObserverList<void(const int&)> observerList;
+    std::deque<ObserverConnection> observerConnections;
+    for (size_t i = 0; i < observers; i++)
+        observerConnections.push_back(observerList.connect([&sink](const int& value) {
+            sink = value;
+        }));
+
+    boost::signals2::signal<void(const int&)> signal;
+    std::deque<boost::signals2::scoped_connection> signalConnections;
+    for (size_t i = 0; i < observers; i++)
+        signalConnections.push_back(signal.connect([&sink](const int& value) { sink = value; }));
+
+    auto observerListCost = measureNanosecondsPerEmission(emissions, [&](int value) {
+        observerList(value);
+    });
+    auto signalCost = measureNanosecondsPerEmission(emissions, [&](int value) { signal(value); });
+
+    EmissionSequencer sequencer;
+    SpinLock lock(&sequencer);
+    auto sequencedCost =
+        measureSequencedNanosecondsPerEmission(emissions, 1, lock, sequencer, observerList);
+    auto contendedCost =
+        measureSequencedNanosecondsPerEmission(emissions, producers, lock, sequencer, observerList);
+
+    std::cout << "observers=" << observers << " emissions=" << emissions << std::endl;
+    std::cout << "ObserverList:             " << observerListCost << " ns/emission" << std::endl;
+    std::cout << "boost::signals2::signal:  " << signalCost << " ns/emission" << std::endl;
+    std::cout << "EmissionSequencer:        " << sequencedCost << " ns/emission" << std::endl;
+    std::cout << "EmissionSequencer (" << producers << " producers): " << contendedCost
+              << " ns/emission" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+// Compares stringToNumber() and validateRange() with the boost::lexical_cast and
+// boost::numeric_cast conversion they replaced, using typical mutation inputs, and the
+// list validateRange() with an element by element loop for list arguments.
+//
+// Usage: bench_scalars [conversions] [list size]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+
+#include <graphql_vss_server_libs/support/scalars.hpp>
+
+template <typename T>
+static T lexicalStringToNumber(const std::string& str)
+{
+    if (str.find('.') != std::string::npos)
+        return boost::numeric_cast<T>(boost::lexical_cast<double>(str));
+    if (str.at(0) == '-')
+        return boost::numeric_cast<T>(boost::lexical_cast<int64_t>(str));
+    return boost::numeric_cast<T>(boost::lexical_cast<uint64_t>(str));
+}
+
+template <typename Fn>
+static double measureNanosecondsPerConversion(size_t conversions, Fn&& convert)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < conversions; i++)
+        convert(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / conversions;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t conversions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t listSize = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 96;
+    volatile double sink = 0;
+
+    const std::vector<std::string> integers = { "0", "42", "-17", "255", "1000", "-32768" };
+    const std::vector<std::string> floats = { "0.5", "-12.25", "3.14159", "100.0", "-0.001" };
+    const RangeInterval<int32_t> intRange { -100000, 100000 };
+    const RangeInterval<double> floatRange { -1000, 1000 };
+
+    auto lexicalIntegerCost = measureNanosecondsPerConversion(conversions, [&](size_t i) {
+        sink = lexicalStringToNumber<int32_t>(integers[i % integers.size()]);
+    });
+    auto integerCost = measureNanosecondsPerConversion(conversions, [&](size_t i) {
+        sink = stringToNumber<int32_t>(integers[i % integers.size()]);
+    });
+    auto lexicalFloatCost = measureNanosecondsPerConversion(conversions, [&](size_t i) {
+        sink = lexicalStringToNumber<float>(floats[i % floats.size()]);
+    });
+    auto floatCost = measureNanosecondsPerConversion(conversions, [&](size_t i) {
+        sink = stringToNumber<float>(floats[i % floats.size()]);
+    });
+    auto numericCastRangeCost = measureNanosecondsPerConversion(conversions, [&](size_t i) {
+        auto value = boost::numeric_cast<int32_t>(static_cast<int>(i % 200000) - 100000);
+        if (value < intRange.min || value > intRange.max)
+            throw std::out_of_range("Value out of range");
+        sink = value;
+    });
+    auto intRangeCost = measureNanosecondsPerConversion(conversions, [&](size_t i) {
+        sink = validateRange(static_cast<int>(i % 200000) - 100000, intRange);
+    });
+    auto floatRangeCost = measureNanosecondsPerConversion(conversions, [&](size_t i) {
+        sink = validateRange(static_cast<double>(i % 2000) - 999.5, floatRange);
+    });
+
+    std::vector<int> cellLimits(listSize);
+    for (size_t i = 0; i < listSize; i++)
+        cellLimits[i] = static_cast<int>(i % 100);
+    const RangeInterval<uint8_t> cellRange { 0, 100 };
+    auto elementListCost = measureNanosecondsPerConversion(conversions / listSize, [&](size_t) {
+        std::vector<uint8_t> result;
+        result.reserve(cellLimits.size());
+        for (auto limit : cellLimits)
+            result.push_back(validateRange(limit, cellRange));
+        sink = result.back();
+    });
+    auto listCost = measureNanosecondsPerConversion(conversions / listSize, [&](size_t) {
+        sink = validateRange(cellLimits, cellRange).back();
+    });
+
+    std::cout << "conversions=" << conversions << " list size=" << listSize << std::endl;
+    std::cout << "lexical_cast<int32_t>:          " << lexicalIntegerCost << " ns/conversion"
+              << std::endl;
+    std::cout << "stringToNumber<int32_t>:        " << integerCost << " ns/conversion" << std::endl;
+    std::cout << "lexical_cast<float>:            " << lexicalFloatCost << " ns/conversion"
+              << std::endl;
+    std::cout << "stringToNumber<float>:          " << floatCost << " ns/conversion" << std::endl;
+    std::cout << "numeric_cast<int32_t> + range:  " << numericCastRangeCost << " ns/conversion"
+              << std::endl;
+    std::cout << "validateRange<int32_t>:         " << intRangeCost << " ns/conversion"
+              << std::endl;
+    std::cout << "validateRange<double>:          " << floatRangeCost << " ns/conversion"
+              << std::endl;
+    std::cout << "validateRange<uint8_t> loop:    " << elementListCost << " ns/list" << std::endl;
+    std::cout << "validateRange<uint8_t> list:    " << listCost << " ns/list" << std::endl;
+
+    return 0;
+}
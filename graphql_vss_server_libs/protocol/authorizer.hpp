@@ -20,6 +20,9 @@ struct Authorizer
 {
     // shared_ptr allows caching authorized tokens (same permissions => same ClientPermissions
     // pointer)
+    //
+    // Called from the server thread pool, concurrently for different connections: implementations
+    // must be thread-safe.
     virtual const std::shared_ptr<const ClientPermissions> authorize(std::string&& token) = 0;
     virtual const std::shared_ptr<const ClientPermissions> authorize(const std::string& token) = 0;
 };
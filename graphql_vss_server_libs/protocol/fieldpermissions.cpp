@@ -0,0 +1,236 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi),
+//   Author: Leandro Ferlin (leandroferlin@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#include <graphqlservice/internal/Grammar.h>
+
+#include <graphql_vss_server_libs/support/debug.hpp>
+
+#include "fieldpermissions.hpp"
+
+namespace {
+
+// Similar to SubscriptionDefinitionNameVisitor, but the query was not validated by cppgraphqlgen
+// yet: unknown fragments or fields and fragment cycles must be handled
+class FieldPermissionsVisitor
+{
+public:
+    FieldPermissionsVisitor(const FieldPermissions& fieldPermissions, const peg::ast_node& root)
+        : m_fieldPermissions(fieldPermissions)
+    {
+        peg::for_each_child<peg::fragment_definition>(root, [this](const peg::ast_node& child) {
+            m_fragments.emplace(child.children.front()->string_view(), &child);
+        });
+    }
+
+    FieldPermissions::Requirements getRequirements()
+    {
+        return std::move(m_requirements);
+    }
+
+    void visitSelectionSet(const peg::ast_node& selectionSet, const std::string_view& type,
+        bool conditional)
+    {
+        for (const auto& child : selectionSet.children)
+        {
+            if (child->is_type<peg::field>())
+                visitField(*child, type, conditional);
+            else if (child->is_type<peg::fragment_spread>())
+                visitFragmentSpread(*child, conditional);
+            else if (child->is_type<peg::inline_fragment>())
+                visitInlineFragment(*child, type, conditional);
+        }
+    }
+
+private:
+    const FieldPermissions& m_fieldPermissions;
+    std::map<std::string_view, const peg::ast_node*> m_fragments;
+    std::set<std::string_view> m_visitingFragments;
+    // fragments already collected (name, conditional), spreading them again adds nothing
+    std::set<std::pair<std::string_view, bool>> m_visitedFragments;
+    FieldPermissions::Requirements m_requirements;
+
+    static bool hasDirectives(const peg::ast_node& node)
+    {
+        bool found = false;
+        peg::on_first_child<peg::directives>(node, [&found](const peg::ast_node&) {
+            found = true;
+        });
+        return found;
+    }
+
+    static std::string_view getTypeCondition(
+        const peg::ast_node& node, const std::string_view& defaultType)
+    {
+        std::string_view type = defaultType;
+        peg::on_first_child<peg::type_condition>(node, [&type](const peg::ast_node& child) {
+            type = child.children.front()->string_view();
+        });
+        return type;
+    }
+
+    void visitField(const peg::ast_node& field, const std::string_view& type, bool conditional)
+    {
+        std::string_view name;
+        peg::on_first_child<peg::field_name>(field, [&name](const peg::ast_node& child) {
+            name = child.string_view();
+        });
+
+        if (name.substr(0, 2) == "__")
+            return; // introspection
+
+        const auto info = m_fieldPermissions.find(type, name);
+        if (!info)
+        {
+            dbg(COLOR_BG_BLUE << "FieldPermissions: unknown field " << type << "." << name);
+            m_requirements.complete = false;
+            return;
+        }
+
+        conditional = conditional || hasDirectives(field);
+        auto& permissions = conditional ? m_requirements.conditional : m_requirements.required;
+        for (const auto& permission : info->permissions)
+            permissions.insert(permission);
+
+        peg::on_first_child<peg::selection_set>(field,
+            [this, &info, conditional](const peg::ast_node& child) {
+                visitSelectionSet(child, info->type, conditional);
+            });
+    }
+
+    void visitFragmentSpread(const peg::ast_node& fragmentSpread, bool conditional)
+    {
+        const auto name = fragmentSpread.children.front()->string_view();
+        const auto itr = m_fragments.find(name);
+        if (itr == m_fragments.end() || !m_visitingFragments.insert(name).second)
+        {
+            // unknown or cyclic, the operation will fail validation
+            m_requirements.complete = false;
+            return;
+        }
+
+        const auto& fragment = *itr->second;
+        conditional = conditional || hasDirectives(fragmentSpread) || hasDirectives(fragment);
+        if (m_visitedFragments.count({ name, false }) == 0
+            && m_visitedFragments.insert({ name, conditional }).second)
+        {
+            visitSelectionSet(*fragment.children.back(),
+                getTypeCondition(fragment, std::string_view()),
+                conditional);
+        }
+
+        m_visitingFragments.erase(name);
+    }
+
+    void visitInlineFragment(
+        const peg::ast_node& inlineFragment, const std::string_view& type, bool conditional)
+    {
+        conditional = conditional || hasDirectives(inlineFragment);
+        const auto fragmentType = getTypeCondition(inlineFragment, type);
+        peg::on_first_child<peg::selection_set>(inlineFragment,
+            [this, &fragmentType, conditional](const peg::ast_node& child) {
+                visitSelectionSet(child, fragmentType, conditional);
+            });
+    }
+};
+
+} // namespace
+
+void FieldPermissions::PermissionSet::insert(const ClientPermissions::Key& permission)
+{
+    if (PermissionMask::isDense(permission))
+        m_dense.set(permission);
+    else
+        m_sparse.insert(permission);
+}
+
+bool FieldPermissions::PermissionSet::isSatisfiedBy(
+    const ClientPermissions& permissions) const noexcept
+{
+    if (!permissions.containsAll(m_dense))
+        return false;
+    for (const auto& permission : m_sparse)
+    {
+        if (!permissions.contains(permission))
+            return false;
+    }
+    return true;
+}
+
+FieldPermissions::FieldPermissions(
+    std::string queryType, std::string mutationType, std::string subscriptionType)
+    : m_queryType(std::move(queryType))
+    , m_mutationType(std::move(mutationType))
+    , m_subscriptionType(std::move(subscriptionType))
+{
+}
+
+void FieldPermissions::add(
+    const std::string_view& parentType, const std::string_view& fieldName, Field&& field)
+{
+    auto itr = m_types.find(parentType);
+    if (itr == m_types.end())
+        itr = m_types.emplace(std::string { parentType }, std::map<std::string, Field, std::less<>>())
+                  .first;
+    itr->second.insert_or_assign(std::string { fieldName }, std::move(field));
+}
+
+const FieldPermissions::Field* FieldPermissions::find(
+    const std::string_view& parentType, const std::string_view& fieldName) const noexcept
+{
+    const auto type = m_types.find(parentType);
+    if (type == m_types.cend())
+        return nullptr;
+
+    const auto field = type->second.find(fieldName);
+    if (field == type->second.cend())
+        return nullptr;
+
+    return &field->second;
+}
+
+FieldPermissions::Requirements FieldPermissions::collect(
+    const peg::ast& ast, const std::string_view& operationName) const
+{
+    FieldPermissionsVisitor visitor(*this, *ast.root);
+    bool found = false;
+
+    peg::for_each_child<peg::operation_definition>(*ast.root,
+        [this, &visitor, &found, &operationName](const peg::ast_node& operationDefinition) {
+            std::string_view name;
+            peg::on_first_child<peg::operation_name>(operationDefinition,
+                [&name](const peg::ast_node& child) {
+                    name = child.string_view();
+                });
+            if (found || (!operationName.empty() && name != operationName))
+                return;
+            found = true;
+
+            // the shorthand "{ ... }" is a query
+            std::string_view type = m_queryType;
+            peg::on_first_child<peg::operation_type>(operationDefinition,
+                [this, &type](const peg::ast_node& child) {
+                    const auto operationType = child.string_view();
+                    if (operationType == service::strMutation)
+                        type = m_mutationType;
+                    else if (operationType == service::strSubscription)
+                        type = m_subscriptionType;
+                });
+
+            visitor.visitSelectionSet(*operationDefinition.children.back(), type, false);
+        });
+
+    auto requirements = visitor.getRequirements();
+    if (!found)
+        requirements.complete = false;
+    return requirements;
+}
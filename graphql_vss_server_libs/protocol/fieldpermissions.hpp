@@ -0,0 +1,87 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <graphqlservice/GraphQLService.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <graphql_vss_server_libs/support/permissions.hpp>
+
+#include "graphql_vss_server_libs-protocol_export.h"
+
+using namespace graphql;
+
+// Permissions validated by the resolver of each field, usually generated from the schema together
+// with the resolvers. Allows checking the permissions of a whole operation before resolving it.
+class FieldPermissions
+{
+public:
+    struct Field
+    {
+        // named type of the field value (lists and non-null unwrapped), used to look up the
+        // selected sub-fields. Empty for scalars and enums
+        std::string type;
+        std::vector<ClientPermissions::Key> permissions;
+    };
+
+    class PermissionSet
+    {
+    public:
+        GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT void insert(const ClientPermissions::Key& permission);
+        GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT bool isSatisfiedBy(
+            const ClientPermissions& permissions) const noexcept;
+
+    private:
+        PermissionMask m_dense;
+        std::set<ClientPermissions::Key> m_sparse;
+    };
+
+    struct Requirements
+    {
+        // fields that are always resolved
+        PermissionSet required;
+        // fields under @skip/@include, they may not be resolved
+        PermissionSet conditional;
+        // all the selected fields are known, then resolvers won't validate anything else
+        bool complete = true;
+    };
+
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT FieldPermissions(std::string queryType = "Query",
+        std::string mutationType = "Mutation", std::string subscriptionType = "Subscription");
+
+    FieldPermissions(FieldPermissions const&) = delete;
+    FieldPermissions(FieldPermissions&&) = delete;
+
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT void add(
+        const std::string_view& parentType, const std::string_view& fieldName, Field&& field);
+
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT const Field* find(
+        const std::string_view& parentType, const std::string_view& fieldName) const noexcept;
+
+    // Walks the selections of the operation (and its fragments) collecting the permissions.
+    // Introspection fields (__typename, __schema...) don't require permissions.
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT Requirements collect(
+        const peg::ast& ast, const std::string_view& operationName) const;
+
+private:
+    const std::string m_queryType;
+    const std::string m_mutationType;
+    const std::string m_subscriptionType;
+
+    std::map<std::string, std::map<std::string, Field, std::less<>>, std::less<>> m_types;
+};
@@ -11,6 +11,8 @@
 // not distributed with this file, You can obtain one at
 // http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+
 #include <graphql_vss_server_libs/support/debug.hpp>
 #include <graphql_vss_server_libs/support/log.hpp>
 // Added to backward compatibility with older versions of DLT Daemon
@@ -31,12 +33,14 @@ GraphQLConnection::~GraphQLConnection()
 }
 
 void GraphQLConnection::setup(Authorizer* authorizer, service::Request* executableSchema,
-    SingletonStorage* singletonStorage, GraphQLRequestHandlers&& handlers)
+    const FieldPermissions* fieldPermissions, SingletonStorage* singletonStorage,
+    GraphQLRequestHandlers&& handlers)
 {
     dbg(COLOR_BG_GREEN << "GraphQLConnection setup " << this);
 
     m_authorizer = authorizer;
     m_executableSchema = executableSchema;
+    m_fieldPermissions = fieldPermissions;
     m_singletonStorage = singletonStorage;
     // handlers are bound to the server, thus we introduce a ref-cycle, tearDown() fixes it
     m_handlers = std::move(handlers);
@@ -59,6 +63,7 @@ void GraphQLConnection::tearDown()
 
     m_authorizer = nullptr;
     m_executableSchema = nullptr;
+    m_fieldPermissions = nullptr;
     m_singletonStorage = nullptr;
     // forceful release resources, specially the following as they contain ref-cycles
     m_handlers = {};
@@ -75,6 +80,9 @@ void GraphQLConnection::stop()
     dbg(COLOR_BG_GREEN << "GraphQLConnection stop " << this
                        << " operations=" << m_operations.size());
 
+    m_authorizationToken = nullptr;
+    m_pendingStarts.clear();
+
     auto operations = std::move(m_operations);
     for (auto& it : operations)
     {
@@ -96,8 +104,11 @@ void GraphQLConnection::onHttp(const std::string& authorization, response::Value
             DLT_PTR(this),
             DLT_CSTRING("http, authorization="),
             DLT_SIZED_UTF8(authorization.data(), authorization.size()));
-        m_permissions = m_authorizer->authorize(authorization);
-        onGraphQLMessage(GQL_START, id, std::move(payload));
+        // std::function must be copyable, thus share the payload with the single caller
+        auto request = std::make_shared<response::Value>(std::move(payload));
+        authorize(std::string { authorization }, GQL_CONNECTION_ERROR, id, [this, id, request] {
+            onGraphQLMessage(GQL_START, id, std::move(*request));
+        });
     }
     catch (std::exception& ex)
     {
@@ -164,12 +175,18 @@ void GraphQLConnection::onGraphQLConnectionInit(response::Value&& payload)
                 DLT_CSTRING("ws, authorization="),
                 DLT_SIZED_UTF8(m.second.get<response::StringType>().data(),
                     m.second.get<response::StringType>().size()));
-            m_permissions = m_authorizer->authorize(m.second.release<response::StringType>());
-            break;
+            authorize(m.second.release<response::StringType>(), GQL_CONNECTION_ERROR, "", [this] {
+                reply(response::helpers::createResponse(GQL_CONNECTION_ACK, "", response::Value()));
+            });
+            return;
         }
     }
 
+    // supersedes the authorization of a previous connection_init, if still pending, so its
+    // result doesn't replace the permissions later
+    m_authorizationToken = nullptr;
     reply(response::helpers::createResponse(GQL_CONNECTION_ACK, "", response::Value()));
+    startPendingOperations();
 }
 
 void GraphQLConnection::onGraphQLConnectionTerminate()
@@ -188,6 +205,13 @@ void GraphQLConnection::onGraphQLStart(const std::string_view& id, response::Val
     if (id.empty())
         throw InvalidPayload("missing 'id'");
 
+    if (m_authorizationToken)
+    {
+        dbg(COLOR_BG_BLUE << "GraphQLConnection start: authorization pending, queue id=" << id);
+        m_pendingStarts.emplace_back(std::string { id }, std::move(payload));
+        return;
+    }
+
     auto itr = m_operations.find(id);
     if (itr != m_operations.end())
     {
@@ -200,6 +224,16 @@ void GraphQLConnection::onGraphQLStart(const std::string_view& id, response::Val
 
 void GraphQLConnection::onGraphQLStop(const std::string_view& id)
 {
+    auto pending = std::find_if(m_pendingStarts.begin(), m_pendingStarts.end(), [&id](auto& it) {
+        return it.first == id;
+    });
+    if (pending != m_pendingStarts.end())
+    {
+        dbg(COLOR_BG_BLUE << "GraphQLConnection stop: removed pending start id=" << id);
+        m_pendingStarts.erase(pending);
+        return;
+    }
+
     auto itr = m_operations.find(id);
     if (itr == m_operations.end())
     {
@@ -225,6 +259,7 @@ GraphQLConnection::addConnectionOperation(const std::string_view& id, response::
     auto op = GraphQLConnectionOperation::make(id,
         m_handlers,
         *m_executableSchema,
+        m_fieldPermissions,
         m_permissions,
         *m_singletonStorage,
         std::move(payload));
@@ -251,3 +286,97 @@ void GraphQLConnection::reply(response::Value&& response) noexcept
     }
     m_handlers.onReply(std::move(response));
 }
+
+void GraphQLConnection::authorize(std::string&& token, const std::string_view& errorType,
+    const std::string_view& errorId, std::function<void(void)>&& onAuthorized)
+{
+    if (!m_handlers.offloadWork)
+    {
+        dbg(COLOR_BG_BLUE << "GraphQLConnection " << this
+                          << " already torn down, ignore authorize");
+        return;
+    }
+
+    // a newer authorization replaces the pending one, its result is discarded
+    m_authorizationToken = std::make_shared<bool>(true);
+    std::weak_ptr<void> weakToken = m_authorizationToken;
+
+    // m_handlers and m_authorizer are released by tearDown(), keep what the thread pool uses
+    m_handlers.offloadWork([this,
+                               authorizer = m_authorizer,
+                               defer = m_handlers.defer,
+                               weakToken,
+                               token = std::move(token),
+                               errorType = std::string { errorType },
+                               errorId = std::string { errorId },
+                               onAuthorized = std::move(onAuthorized)]() mutable {
+        std::shared_ptr<const ClientPermissions> permissions;
+        std::exception_ptr error;
+        try
+        {
+            permissions = authorizer->authorize(std::move(token));
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        defer([this,
+                  weakToken,
+                  permissions = std::move(permissions),
+                  error,
+                  errorType = std::move(errorType),
+                  errorId = std::move(errorId),
+                  onAuthorized = std::move(onAuthorized)]() mutable {
+            if (weakToken.expired())
+                return; // stopped or superseded meanwhile
+
+            onAuthorizationDone(std::move(permissions), error, errorType, errorId, onAuthorized);
+        });
+    });
+}
+
+void GraphQLConnection::onAuthorizationDone(std::shared_ptr<const ClientPermissions>&& permissions,
+    std::exception_ptr error, const std::string& errorType, const std::string& errorId,
+    const std::function<void(void)>& onAuthorized) noexcept
+{
+    m_authorizationToken = nullptr;
+
+    try
+    {
+        if (error)
+            std::rethrow_exception(error);
+
+        m_permissions = std::move(permissions);
+        onAuthorized();
+    }
+    catch (std::exception& ex)
+    {
+        DLT_LOG(dltConnection,
+            DLT_LOG_WARN,
+            DLT_CSTRING("connection="),
+            DLT_PTR(this),
+            DLT_CSTRING("authorization failed:"),
+            DLT_STRING(ex.what()));
+        reply(response::helpers::createErrorResponse(errorType, errorId, ex));
+    }
+
+    startPendingOperations();
+}
+
+void GraphQLConnection::startPendingOperations() noexcept
+{
+    // same as if they were received after the (possibly failed) authorization
+    auto pendingStarts = std::move(m_pendingStarts);
+    for (auto& [id, payload] : pendingStarts)
+    {
+        try
+        {
+            onGraphQLStart(id, std::move(payload));
+        }
+        catch (std::exception& ex)
+        {
+            reply(response::helpers::createErrorResponse(GQL_ERROR, id, ex));
+        }
+    }
+}
@@ -14,6 +14,8 @@
 
 #include <graphqlservice/GraphQLService.h>
 
+#include <deque>
+
 #include "graphqlconnectionoperation.hpp"
 
 using namespace graphql;
@@ -32,7 +34,8 @@ public:
     // The connection is constructed by websocket::server and we can't pass extra parameters, then
     // we need this
     void setup(Authorizer* authorizer, service::Request* executableSchema,
-        SingletonStorage* singletonStorage, GraphQLRequestHandlers&& handlers);
+        const FieldPermissions* fieldPermissions, SingletonStorage* singletonStorage,
+        GraphQLRequestHandlers&& handlers);
 
     // Release any references, in particular the circular ones
     void tearDown();
@@ -50,12 +53,19 @@ public:
 private:
     Authorizer* m_authorizer;
     service::Request* m_executableSchema;
+    const FieldPermissions* m_fieldPermissions;
     SingletonStorage* m_singletonStorage;
     GraphQLRequestHandlers m_handlers;
 
     std::shared_ptr<const ClientPermissions> m_permissions;
     std::map<std::string_view, std::shared_ptr<GraphQLConnectionOperation>> m_operations;
 
+    // Set while the authorizer runs on the thread pool, results arriving after it was reset
+    // (stop/tearDown or a newer authorization) are discarded. Starts received meanwhile are
+    // queued and only executed once m_permissions is known.
+    std::shared_ptr<bool> m_authorizationToken;
+    std::deque<std::pair<std::string, response::Value>> m_pendingStarts;
+
 protected:
     void onGraphQLMessage(
         const std::string_view& type, const std::string_view& id, response::Value&& payload);
@@ -67,4 +77,14 @@ protected:
     std::shared_ptr<GraphQLConnectionOperation>
     addConnectionOperation(const std::string_view& id, response::Value&& payload);
     void reply(response::Value&& response) noexcept;
+
+    // Verifying tokens is CPU expensive (ie: RS256 signatures), then it's done in the thread pool
+    // and onAuthorized() is called from the main thread. Errors are replied as errorType/errorId
+    void authorize(std::string&& token, const std::string_view& errorType,
+        const std::string_view& errorId, std::function<void(void)>&& onAuthorized);
+    void onAuthorizationDone(std::shared_ptr<const ClientPermissions>&& permissions,
+        std::exception_ptr error, const std::string& errorType, const std::string& errorId,
+        const std::function<void(void)>& onAuthorized) noexcept;
+    // Starts the operations queued while the authorization was pending
+    void startPendingOperations() noexcept;
 };
@@ -76,7 +76,7 @@ public:
         std::chrono::milliseconds intervalInMs) noexcept override;
 
 protected:
-    void addScopedSignalConnection(boost::signals2::scoped_connection&& con) noexcept override;
+    void addScopedSignalConnection(ObserverConnection&& con) noexcept override;
     void notify() noexcept override;
 
 private:
@@ -94,7 +94,7 @@ private:
 
     // Observers
     SpinLock m_scopedSignalConnectionsLock = SpinLock(this);
-    std::deque<boost::signals2::scoped_connection> m_scopedSignalConnections;
+    std::deque<ObserverConnection> m_scopedSignalConnections;
 
     inline std::shared_ptr<GraphQLConnectionOperationSubscription> getSharedPtr()
     {
@@ -141,8 +141,9 @@ static inline bool decideIsSubscription(const std::string& query)
 
 std::shared_ptr<GraphQLConnectionOperation>
 GraphQLConnectionOperation::make(const std::string_view& id, const GraphQLRequestHandlers& handlers,
-    service::Request& executableSchema, std::shared_ptr<const ClientPermissions> permissions,
-    SingletonStorage& singletonStorage, response::Value&& payload)
+    service::Request& executableSchema, const FieldPermissions* fieldPermissions,
+    std::shared_ptr<const ClientPermissions> permissions, SingletonStorage& singletonStorage,
+    response::Value&& payload)
 {
     auto [query, operationName, variables] =
         response::helpers::toOperationDefinitionParts(std::move(payload));
@@ -155,6 +156,7 @@ GraphQLConnectionOperation::make(const std::string_view& id, const GraphQLReques
         return std::make_shared<GraphQLConnectionOperationSubscription>(id,
             handlers,
             executableSchema,
+            fieldPermissions,
             permissions,
             singletonStorage,
             isSubscription,
@@ -165,6 +167,7 @@ GraphQLConnectionOperation::make(const std::string_view& id, const GraphQLReques
         return std::make_shared<GraphQLConnectionOperationRegular>(id,
             handlers,
             executableSchema,
+            fieldPermissions,
             permissions,
             singletonStorage,
             isSubscription,
@@ -175,15 +178,16 @@ GraphQLConnectionOperation::make(const std::string_view& id, const GraphQLReques
 
 GraphQLConnectionOperation::GraphQLConnectionOperation(const std::string_view& id,
     const GraphQLRequestHandlers& handlers, service::Request& executableSchema,
-    std::shared_ptr<const ClientPermissions> permissions, SingletonStorage& singletonStorage,
-    bool isSubscription, std::string&& query, std::string&& operationName,
-    response::Value&& variables)
+    const FieldPermissions* fieldPermissions, std::shared_ptr<const ClientPermissions> permissions,
+    SingletonStorage& singletonStorage, bool isSubscription, std::string&& query,
+    std::string&& operationName, response::Value&& variables)
     : GraphQLRequestState(handlers, executableSchema, permissions, singletonStorage, isSubscription)
     , m_id(id)
     , m_stopped(false)
     , m_query(std::move(query))
     , m_operationName(std::move(operationName))
     , m_variables(std::move(variables))
+    , m_fieldPermissions(fieldPermissions)
 {
     dbg(COLOR_BG_BLUE << "GraphQLConnectionOperation " << this << " id=" << m_id);
 }
@@ -193,6 +197,88 @@ GraphQLConnectionOperation::~GraphQLConnectionOperation()
     dbg(COLOR_BG_BLUE << "~GraphQLConnectionOperation " << this << " id=" << m_id);
 }
 
+bool GraphQLConnectionOperation::preCheckPermissions(const peg::ast& ast) noexcept
+{
+    // without permissions resolvers throw ContextException as usual
+    if (!m_fieldPermissions || !m_permissions || m_didPermissionsCheck)
+        return true;
+
+    try
+    {
+        const auto requirements = m_fieldPermissions->collect(ast, m_operationName);
+        if (!requirements.required.isSatisfiedBy(*m_permissions))
+        {
+            m_failedPermissionsCheck = true;
+            dbg(COLOR_BG_RED << "GraphQLConnectionOperation " << this << " id=" << m_id
+                             << ": failed permissions pre-check");
+            DLT_LOG(dltOperation,
+                DLT_LOG_WARN,
+                DLT_CSTRING("operation="),
+                DLT_PTR(this),
+                DLT_CSTRING(" id="),
+                DLT_SIZED_STRING(m_id.data(), m_id.size()),
+                DLT_CSTRING(": failed permissions pre-check"));
+            return false;
+        }
+
+        if (requirements.complete && requirements.conditional.isSatisfiedBy(*m_permissions))
+        {
+            dbg(COLOR_BG_BLUE << "GraphQLConnectionOperation " << this << " id=" << m_id
+                              << ": permissions pre-checked, skip resolvers checks");
+            m_didPermissionsCheck = true;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        // resolvers still check, just log it
+        dbg(COLOR_BG_RED << "GraphQLConnectionOperation " << this << " id=" << m_id
+                         << ": permissions pre-check error: " << ex.what());
+    }
+
+    return true;
+}
+
+void GraphQLConnectionOperation::addDeniedFieldsError(response::Value& document) noexcept
+{
+    const auto deniedFields = m_deniedFields.exchange(0, std::memory_order_relaxed);
+    if (deniedFields == 0 || document.type() != response::Type::Map)
+        return;
+
+    dbg(COLOR_BG_RED << "GraphQLConnectionOperation " << this << " id=" << m_id
+                     << ": denied fields=" << deniedFields);
+
+    // resolvers returned null, there are no errors for those fields, add one for all of them
+    auto members = document.release<response::MapType>();
+    response::Value errors(response::Type::List);
+    for (auto itr = members.begin(); itr != members.end(); ++itr)
+    {
+        if (itr->first == strErrors)
+        {
+            errors = std::move(itr->second);
+            members.erase(itr);
+            break;
+        }
+    }
+
+    service::schema_exception ex(std::vector<std::string> { PermissionException().what() });
+    for (auto& error : ex.getErrors().release<response::ListType>())
+        errors.emplace_back(std::move(error));
+
+    document = response::Value(response::Type::Map);
+    for (auto& member : members)
+        document.emplace_back(std::move(member.first), std::move(member.second));
+    document.emplace_back(std::string { strErrors }, std::move(errors));
+}
+
+static response::Value createPermissionDeniedDocument()
+{
+    service::schema_exception ex(std::vector<std::string> { PermissionException().what() });
+    response::Value document(response::Type::Map);
+    document.emplace_back(std::string { strData }, response::Value());
+    document.emplace_back(std::string { strErrors }, ex.getErrors());
+    return document;
+}
+
 // GraphQLConnectionOperationRegular
 void GraphQLConnectionOperationRegular::start() noexcept
 {
@@ -264,6 +350,15 @@ void GraphQLConnectionOperationRegular::resolveInAThread() noexcept
 
     auto ast = peg::parseString(m_query);
 
+    if (!preCheckPermissions(ast))
+    {
+        onReply(response::helpers::createResponse(
+            GQL_DATA, m_id, createPermissionDeniedDocument()));
+        onReply(response::helpers::createResponse(GQL_COMPLETE, m_id, response::Value()));
+        m_stopped = true;
+        return;
+    }
+
 #ifdef GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_DEBUG
     auto startTime = std::chrono::high_resolution_clock::now();
 #endif
@@ -286,6 +381,7 @@ void GraphQLConnectionOperationRegular::resolveInAThread() noexcept
                               << ": already stopped, ignore reply");
             return;
         }
+        addDeniedFieldsError(response);
         onReply(response::helpers::createResponse(GQL_DATA, m_id, std::move(response)));
         onReply(response::helpers::createResponse(GQL_COMPLETE, m_id, response::Value()));
 
@@ -391,6 +487,16 @@ void GraphQLConnectionOperationSubscription::subscribeInAThread() noexcept
 
     auto ast = peg::parseString(m_query);
 
+    if (!preCheckPermissions(ast))
+    {
+        // delivered as an error and then force stopped, as when resolvers fail the check
+        std::promise<response::Value> promise;
+        promise.set_value(createPermissionDeniedDocument());
+        resolveSubscriptionInAThread(
+            std::make_shared<std::future<response::Value>>(promise.get_future()));
+        return;
+    }
+
     auto spThis = getSharedPtr();
     try
     {
@@ -630,6 +736,8 @@ void GraphQLConnectionOperationSubscription::resolveSubscriptionInAThread(
     auto startTime = std::chrono::high_resolution_clock::now();
 #endif
 
+    // values memoized by the previous delivery are outdated
+    clearMemoizedValues();
     auto response = futureResponse.get();
 
 #ifdef GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_DEBUG
@@ -645,6 +753,7 @@ void GraphQLConnectionOperationSubscription::resolveSubscriptionInAThread(
                           << ": already stopped, ignore reply");
         return;
     }
+    addDeniedFieldsError(response);
     onReply(response::helpers::createResponse(GQL_DATA, m_id, std::move(response)));
 
     dbg(COLOR_BG_BLUE << "GraphQLConnectionOperation " << this << " id=" << m_id
@@ -672,7 +781,7 @@ void GraphQLConnectionOperationSubscription::resolveSubscriptionInAThread(
 }
 
 void GraphQLConnectionOperationSubscription::addScopedSignalConnection(
-    boost::signals2::scoped_connection&& con) noexcept
+    ObserverConnection&& con) noexcept
 {
     std::lock_guard<SpinLock> guard(m_scopedSignalConnectionsLock);
     m_scopedSignalConnections.push_back(std::move(con));
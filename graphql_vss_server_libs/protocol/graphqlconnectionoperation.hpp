@@ -16,6 +16,7 @@
 
 #include <chrono>
 
+#include "fieldpermissions.hpp"
 #include "graphqlrequeststate.hpp"
 #include "graphql_vss_server_libs-protocol_export.h"
 
@@ -24,13 +25,15 @@ class GraphQLConnectionOperation : public GraphQLRequestState
 public:
     static std::shared_ptr<GraphQLConnectionOperation>
     make(const std::string_view& id, const GraphQLRequestHandlers& handlers,
-        service::Request& executableSchema, std::shared_ptr<const ClientPermissions> permissions,
-        SingletonStorage& singletonStorage, response::Value&& payload);
+        service::Request& executableSchema, const FieldPermissions* fieldPermissions,
+        std::shared_ptr<const ClientPermissions> permissions, SingletonStorage& singletonStorage,
+        response::Value&& payload);
 
     GraphQLConnectionOperation(const std::string_view& id, const GraphQLRequestHandlers& handlers,
-        service::Request& executableSchema, std::shared_ptr<const ClientPermissions> permissions,
-        SingletonStorage& singletonStorage, bool isSubscription, std::string&& query,
-        std::string&& operationName, response::Value&& variables);
+        service::Request& executableSchema, const FieldPermissions* fieldPermissions,
+        std::shared_ptr<const ClientPermissions> permissions, SingletonStorage& singletonStorage,
+        bool isSubscription, std::string&& query, std::string&& operationName,
+        response::Value&& variables);
     virtual ~GraphQLConnectionOperation();
 
     GraphQLConnectionOperation(GraphQLConnectionOperation const&) = delete;
@@ -56,6 +59,15 @@ protected:
     const std::string m_query; // keep alive as queryAst may point to it
     const std::string m_operationName;
     response::Value m_variables;
+    const FieldPermissions* m_fieldPermissions; // optional
+
+    // Checks the permissions of the whole operation before resolving it, if m_fieldPermissions
+    // is set. Returns false if the client misses any of the permissions, otherwise resolvers may
+    // skip their checks (m_didPermissionsCheck) if all selected fields are known.
+    bool preCheckPermissions(const peg::ast& ast) noexcept;
+
+    // Adds a permission error to the response if tryValidate() denied any field
+    void addDeniedFieldsError(response::Value& document) noexcept;
 
 #if GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_DEBUG
     const std::thread::id m_threadId = std::this_thread::get_id();
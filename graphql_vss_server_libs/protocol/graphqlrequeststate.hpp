@@ -21,8 +21,10 @@
                // <boost/asio/signal_set.hpp>
 
 #include <graphqlservice/GraphQLService.h>
-#include <boost/signals2.hpp>
 
+#include <atomic>
+
+#include <graphql_vss_server_libs/support/observers.hpp>
 #include <graphql_vss_server_libs/support/permissions.hpp>
 #include <graphql_vss_server_libs/support/singleton.hpp>
 
@@ -32,6 +34,13 @@
 
 using namespace graphql;
 
+enum class PermissionStatus
+{
+    Granted,
+    Denied, // client lacks some of the permissions, validate() throws PermissionException
+    MissingContext, // no client permissions at all, validate() throws ContextException
+};
+
 class GraphQLRequestState : public service::RequestState
 {
 public:
@@ -51,26 +60,42 @@ public:
     template <typename... T>
     inline void validate(const T&... requiredPermissions)
     {
-        if (m_didPermissionsCheck)
-            return;
-        if (!m_permissions)
-        {
-            m_failedPermissionsCheck = true;
-            throw ContextException();
-        }
-        try
-        {
-            m_permissions->validate(requiredPermissions...);
-        }
-        catch (PermissionException& ex)
-        {
-            m_failedPermissionsCheck = true;
-            throw;
-        }
+        throwIfNotGranted(checkPermissions([&](const ClientPermissions& permissions) {
+            return permissions.containsAll(requiredPermissions...);
+        }));
+    }
+
+    // Preferred when the permissions are constants (ie: generated resolvers), the mask is built
+    // at compile time
+    template <ClientPermissions::Key... requiredPermissions>
+    inline void validate()
+    {
+        throwIfNotGranted(checkPermissions([](const ClientPermissions& permissions) {
+            return permissions.containsAll<requiredPermissions...>();
+        }));
+    }
+
+    // Same as validate(), but doesn't throw: unwinding is expensive when most fields are denied
+    // (ie: lists for restricted clients). Resolvers should return null if not granted, the
+    // operation then reports a single permission error.
+    template <typename... T>
+    [[nodiscard]] inline PermissionStatus tryValidate(const T&... requiredPermissions) noexcept
+    {
+        return countDenied(checkPermissions([&](const ClientPermissions& permissions) {
+            return permissions.containsAll(requiredPermissions...);
+        }));
+    }
+
+    template <ClientPermissions::Key... requiredPermissions>
+    [[nodiscard]] inline PermissionStatus tryValidate() noexcept
+    {
+        return countDenied(checkPermissions([](const ClientPermissions& permissions) {
+            return permissions.containsAll<requiredPermissions...>();
+        }));
     }
 
     template <typename TSignal>
-    inline void observe(boost::signals2::signal<void(TSignal)>& signal)
+    inline void observe(ObserverList<void(TSignal)>& signal)
     {
         if (!m_isSubscription)
             return;
@@ -106,6 +131,38 @@ public:
         return singleton;
     }
 
+    // Request-scoped memoization (DataLoader-like) for singletons providing
+    // getSharedValue(), ie: CommonAPIAlwaysGetValueProxyAttribute. The first call in
+    // this operation fetches, the following ones reuse the same value. Subscriptions
+    // forget the memoized values before each resolution.
+    template <typename TSingletonValue>
+    inline std::shared_ptr<const typename TSingletonValue::Value> getMemoizedValue()
+    {
+        typedef std::shared_ptr<const typename TSingletonValue::Value> SharedValue;
+        auto key = Singleton<TSingletonValue>::getKey();
+
+        std::unique_lock lock(m_memoizedValuesLock);
+        auto itr = m_memoizedValues.find(key);
+        if (itr != m_memoizedValues.end())
+            return std::static_pointer_cast<const typename TSingletonValue::Value>(itr->second);
+        lock.unlock();
+
+        // concurrent misses join a single fetch, started after this call
+        SharedValue value = getSingleton<TSingletonValue>()->getSharedValue();
+
+        lock.lock();
+        m_memoizedValues.insert({ key, value });
+        return value;
+    }
+
+    // Use after mutating the value, so the next getMemoizedValue() fetches it again
+    template <typename TSingletonValue>
+    inline void forgetMemoizedValue()
+    {
+        std::lock_guard<SpinLock> lock(m_memoizedValuesLock);
+        m_memoizedValues.erase(Singleton<TSingletonValue>::getKey());
+    }
+
     virtual void
     setSubscriptionmIntervalBetweenDeliveries(std::chrono::milliseconds intervalInMs) noexcept
     {
@@ -121,8 +178,52 @@ protected:
     bool m_failedPermissionsCheck = false;
     SpinLock m_usedSingletonsLock = SpinLock(this);
     std::map<BaseSingleton::Key, BaseSingleton::Ref> m_usedSingletons;
+    SpinLock m_memoizedValuesLock = SpinLock(this);
+    std::map<BaseSingleton::Key, std::shared_ptr<const void>> m_memoizedValues;
+
+    // fields denied by tryValidate(), they must be reported as errors by the operation
+    std::atomic<size_t> m_deniedFields { 0 };
+
+    template <typename TCheck>
+    inline PermissionStatus checkPermissions(TCheck&& check) noexcept
+    {
+        if (m_didPermissionsCheck)
+            return PermissionStatus::Granted;
+        if (!m_permissions)
+        {
+            m_failedPermissionsCheck = true;
+            return PermissionStatus::MissingContext;
+        }
+        if (!check(*m_permissions))
+        {
+            m_failedPermissionsCheck = true;
+            return PermissionStatus::Denied;
+        }
+        return PermissionStatus::Granted;
+    }
+
+    inline PermissionStatus countDenied(PermissionStatus status) noexcept
+    {
+        if (status != PermissionStatus::Granted)
+            m_deniedFields.fetch_add(1, std::memory_order_relaxed);
+        return status;
+    }
+
+    inline void throwIfNotGranted(PermissionStatus status)
+    {
+        if (status == PermissionStatus::MissingContext)
+            throw ContextException();
+        if (status == PermissionStatus::Denied)
+            throw PermissionException();
+    }
+
+    inline void clearMemoizedValues()
+    {
+        std::lock_guard<SpinLock> lock(m_memoizedValuesLock);
+        m_memoizedValues.clear();
+    }
 
-    virtual void addScopedSignalConnection(boost::signals2::scoped_connection&& con) noexcept
+    virtual void addScopedSignalConnection(ObserverConnection&& con) noexcept
     {
     }
 
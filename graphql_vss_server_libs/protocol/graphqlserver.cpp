@@ -59,16 +59,87 @@ void GraphQLServer::startAccept(uint16_t port, bool reuseAddress, std::function<
 {
     dbg(COLOR_BG_BLUE << "run server at port=" << port << " reuseAddress=" << reuseAddress);
     m_webSocketServer.set_reuse_addr(reuseAddress);
+    // listen right away so the port is taken, clients will wait in the backlog until warm-up is done
     m_webSocketServer.listen(port);
-    m_webSocketServer.start_accept();
 
-    if (onReady)
-        defer(std::move(onReady));
+    warmUp([this, port, onReady = std::move(onReady)]() mutable {
+        m_webSocketServer.start_accept();
+
+        if (onReady)
+            defer(std::move(onReady));
+
+        DLT_LOG(dltServer,
+            DLT_LOG_INFO,
+            DLT_CSTRING("start accepting HTTP requests at port="),
+            DLT_UINT16(port));
+    });
+}
+
+void GraphQLServer::addWarmUp(WarmUp&& warmUp)
+{
+    m_warmUps.push_back(std::move(warmUp));
+}
+
+void GraphQLServer::warmUp(std::function<void(void)>&& onDone) noexcept
+{
+    if (m_warmUps.empty())
+    {
+        onDone();
+        return;
+    }
 
     DLT_LOG(dltServer,
         DLT_LOG_INFO,
-        DLT_CSTRING("start accepting HTTP requests at port="),
-        DLT_UINT16(port));
+        DLT_CSTRING("warm up singletons="),
+        DLT_UINT64(m_warmUps.size()));
+    dbg(COLOR_BG_BLUE << "warm up " << m_warmUps.size() << " singletons...");
+
+    m_warmUpToken = std::make_shared<bool>(true);
+    std::weak_ptr<void> token = m_warmUpToken;
+    // only accessed from the main thread
+    auto pending = std::make_shared<size_t>(m_warmUps.size());
+    auto done = std::make_shared<std::function<void(void)>>(std::move(onDone));
+
+    for (const auto& warmUp : m_warmUps)
+    {
+        offloadWork([this, warmUp, token, pending, done] {
+            std::shared_ptr<BaseSingleton::Ref> ref;
+            std::string error;
+            try
+            {
+                ref = std::make_shared<BaseSingleton::Ref>(warmUp(m_singletonStorage));
+            }
+            catch (const std::exception& ex)
+            {
+                error = ex.what();
+            }
+            catch (...)
+            {
+                error = "unknown error";
+            }
+
+            defer([this, ref = std::move(ref), error = std::move(error), token, pending, done] {
+                if (token.expired())
+                    return; // stopped meanwhile
+
+                if (ref)
+                    m_pinnedSingletons.push_back(*ref);
+                else
+                    DLT_LOG(dltServer,
+                        DLT_LOG_WARN,
+                        DLT_CSTRING("failed to warm up singleton: "),
+                        DLT_SIZED_UTF8(error.data(), error.size()));
+
+                if (--*pending > 0)
+                    return;
+
+                dbg(COLOR_BG_BLUE << "warm up done, pinned " << m_pinnedSingletons.size()
+                                  << " singletons");
+                m_warmUpToken.reset();
+                (*done)();
+            });
+        });
+    }
 }
 
 void GraphQLServer::stopListening(std::function<void(void)> onStopped)
@@ -80,6 +151,7 @@ void GraphQLServer::stopListening(std::function<void(void)> onStopped)
 
     dbg(COLOR_BG_BLUE << "stop server (pending connections=" << m_connections.size() << ")");
     m_webSocketServer.stop_listening();
+    m_warmUpToken.reset();
 
     defer([this, onStopped] {
         dbg(COLOR_BG_BLUE << "wait any pending server work to complete...");
@@ -110,6 +182,7 @@ void GraphQLServer::stopListening(std::function<void(void)> onStopped)
             dbg(COLOR_BG_BLUE << "server stopped with pending garbage collect, do it now");
             m_garbageCollectTimer.reset();
         }
+        m_pinnedSingletons.clear();
         m_singletonStorage.clear(); // gc + detach references in use
 
         auto pendingConnections = std::move(m_connections);
@@ -234,6 +307,11 @@ void GraphQLServer::scheduleGarbageCollectIfNeeded() noexcept
         << std::chrono::duration_cast<std::chrono::seconds>(garbageCollectAfter).count() << "s");
 }
 
+void GraphQLServer::setFieldPermissions(const FieldPermissions& fieldPermissions) noexcept
+{
+    m_fieldPermissions = &fieldPermissions;
+}
+
 void GraphQLServer::garbageCollect() noexcept
 {
     dbg(COLOR_BG_BLUE << "GraphQLServer " << this << ": collect garbage");
@@ -248,6 +326,7 @@ void GraphQLServer::onConnectionStart(GraphQLServer::WebSocketConnectionPtr con,
 {
     con->setup(&m_authorizer,
         &m_executableSchema,
+        m_fieldPermissions,
         &m_singletonStorage,
         { std::move(onReply),
             std::bind(&GraphQLServer::defer, this, std::placeholders::_1),
@@ -18,6 +18,7 @@
 #include <websocketpp/server.hpp>
 
 #include <set>
+#include <vector>
 
 #include <graphql_vss_server_libs/support/debug.hpp>
 #include <graphql_vss_server_libs/support/log.hpp>
@@ -27,6 +28,7 @@
 #include "graphqlconnection.hpp"
 
 #include "authorizer.hpp"
+#include "fieldpermissions.hpp"
 
 #include "graphql_vss_server_libs-protocol_export.h"
 
@@ -46,6 +48,36 @@ public:
 
     GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT void garbageCollect() noexcept;
 
+    // Enables checking the permissions of whole operations before resolving them: operations
+    // missing any permission are rejected without resolving any field, the others skip the
+    // resolvers checks if all their fields are in the table.
+    //
+    // Must be called before startAccept(), fieldPermissions must outlive the server
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT void setFieldPermissions(
+        const FieldPermissions& fieldPermissions) noexcept;
+
+    // Creates the singleton and returns a reference to it. It's executed in the
+    // thread pool and must wait for the singleton value to be ready.
+    typedef std::function<BaseSingleton::Ref(SingletonStorage&)> WarmUp;
+
+    // Warm-ups are executed in parallel by startAccept() before connections are
+    // accepted and onReady is called. The resulting singletons are pinned, that is,
+    // they are not garbage collected until stopListening().
+    //
+    // Must be called before startAccept()
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT void addWarmUp(WarmUp&& warmUp);
+
+    template <typename... T>
+    void addWarmUpSingletons()
+    {
+        (addWarmUp([](SingletonStorage& storage) -> BaseSingleton::Ref {
+            auto ref = storage.get<T>();
+            ref.value(); // wait it to be ready, rethrows creation errors
+            return std::move(ref);
+        }),
+            ...);
+    }
+
     GraphQLServer(GraphQLServer const&) = delete;
     GraphQLServer(GraphQLServer&&) = delete;
 
@@ -165,8 +197,14 @@ private:
     std::set<WebSocketConnectionPtr> m_connections;
     Authorizer& m_authorizer;
     service::Request& m_executableSchema;
+    const FieldPermissions* m_fieldPermissions = nullptr;
     SingletonStorage m_singletonStorage;
 
+    std::vector<WarmUp> m_warmUps;
+    std::vector<BaseSingleton::Ref> m_pinnedSingletons;
+    // warm-up results arriving after stopListening() must be ignored
+    std::shared_ptr<void> m_warmUpToken;
+
     boost::asio::thread_pool m_threadPool;
 
     std::unique_ptr<boost::asio::steady_timer> m_notifyTimer;
@@ -189,6 +227,8 @@ private:
     void offloadWork(std::function<void(void)>&& runOnThreadPool) noexcept;
     std::unique_ptr<boost::asio::steady_timer> createTimer() noexcept;
 
+    void warmUp(std::function<void(void)>&& onDone) noexcept;
+
     // NOTE: shared because notifyInMainThread() + bind needs
     void notify(std::shared_ptr<GraphQLNotifyTriggers>&& triggers) noexcept;
     void notifyInMainThread(std::shared_ptr<GraphQLNotifyTriggers> triggers) noexcept;
@@ -11,10 +11,12 @@
 // not distributed with this file, You can obtain one at
 // http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <sstream>
 #include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
 
 #include <graphql_vss_server_libs/support/debug.hpp>
 
@@ -22,18 +24,121 @@
 #include "exceptions.hpp"
 
 JwtAuthorizer::JwtAuthorizer(JwtAuthorizer::Verifier&& jwtVerifier,
-    std::unordered_map<std::string_view, ClientPermissions::Key>&& knownPermissions)
+    std::unordered_map<std::string_view, ClientPermissions::Key>&& knownPermissions,
+    size_t cacheCapacity)
     : Authorizer()
-    , m_jwtVerifier(std::move(jwtVerifier))
+    , m_keySet(std::make_shared<const KeySet>(KeySet { { std::string(), std::move(jwtVerifier) } }))
+    , m_keySetCheckInterval(0)
+    , m_keySetNextCheck(0)
     , m_knownPermissions(std::move(knownPermissions))
+    , m_cacheCapacity(cacheCapacity)
 {
 }
 
+JwtAuthorizer::JwtAuthorizer(const std::filesystem::path& keySetPath,
+    std::unordered_map<std::string_view, ClientPermissions::Key>&& knownPermissions,
+    size_t cacheCapacity, std::chrono::milliseconds keySetCheckInterval)
+    : Authorizer()
+    , m_keySetPath(keySetPath)
+    , m_keySetCheckInterval(keySetCheckInterval)
+    , m_keySetNextCheck(
+          (std::chrono::steady_clock::now() + m_keySetCheckInterval).time_since_epoch().count())
+    , m_keySetWriteTime(std::filesystem::last_write_time(keySetPath))
+    , m_knownPermissions(std::move(knownPermissions))
+    , m_cacheCapacity(cacheCapacity)
+{
+    m_keySet = std::make_shared<const KeySet>(loadKeySet(keySetPath));
+}
+
 JwtAuthorizer::Verifier JwtAuthorizer::createDefaultVerifier(const std::string& pubKey)
 {
     return jwt::verify().allow_algorithm(jwt::algorithm::rs256(pubKey));
 }
 
+JwtAuthorizer::Verifier JwtAuthorizer::createVerifier(
+    const std::string& algorithm, const std::string& pubKey)
+{
+    // verifiers only accept their own algorithm, a token can't pick a weaker one
+    if (algorithm == "RS256")
+        return jwt::verify().allow_algorithm(jwt::algorithm::rs256(pubKey));
+    if (algorithm == "RS384")
+        return jwt::verify().allow_algorithm(jwt::algorithm::rs384(pubKey));
+    if (algorithm == "RS512")
+        return jwt::verify().allow_algorithm(jwt::algorithm::rs512(pubKey));
+    if (algorithm == "PS256")
+        return jwt::verify().allow_algorithm(jwt::algorithm::ps256(pubKey));
+    if (algorithm == "PS384")
+        return jwt::verify().allow_algorithm(jwt::algorithm::ps384(pubKey));
+    if (algorithm == "PS512")
+        return jwt::verify().allow_algorithm(jwt::algorithm::ps512(pubKey));
+    if (algorithm == "ES256")
+        return jwt::verify().allow_algorithm(jwt::algorithm::es256(pubKey));
+    if (algorithm == "ES384")
+        return jwt::verify().allow_algorithm(jwt::algorithm::es384(pubKey));
+    if (algorithm == "ES512")
+        return jwt::verify().allow_algorithm(jwt::algorithm::es512(pubKey));
+    if (algorithm == "EdDSA")
+        return jwt::verify().allow_algorithm(jwt::algorithm::ed25519(pubKey));
+
+    throw std::invalid_argument("Unsupported JWT algorithm: " + algorithm);
+}
+
+JwtAuthorizer::KeySet JwtAuthorizer::loadKeySet(const std::filesystem::path& path)
+{
+    dbg(COLOR_BG_BLUE << "JwtAuthorizer reading key set from=" << path);
+    std::ifstream ifs(path);
+    if (!ifs)
+        throw std::runtime_error("Could not read JWT key set: " + path.string());
+    std::string contents((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
+
+    picojson::value json;
+    const auto error = picojson::parse(json, contents);
+    if (!error.empty())
+        throw std::invalid_argument("Invalid JWT key set: " + error);
+    if (!json.is<picojson::object>())
+        throw std::invalid_argument("JWT key set is not an object");
+
+    const auto& root = json.get<picojson::object>();
+    const auto keys = root.find("keys");
+    if (keys == root.cend() || !keys->second.is<picojson::array>())
+        throw std::invalid_argument("JWT key set does not contain a \"keys\" array");
+
+    KeySet keySet;
+    for (const auto& item : keys->second.get<picojson::array>())
+    {
+        if (!item.is<picojson::object>())
+            throw std::invalid_argument("JWT key set entry is not an object");
+
+        const auto& key = item.get<picojson::object>();
+        const auto getString = [&key](const std::string& name) -> std::string {
+            const auto itr = key.find(name);
+            if (itr == key.cend())
+                return std::string();
+            if (!itr->second.is<std::string>())
+                throw std::invalid_argument("JWT key set entry \"" + name + "\" is not a string");
+            return itr->second.get<std::string>();
+        };
+
+        const auto alg = getString("alg");
+        const auto pem = getString("pem");
+        if (alg.empty() || pem.empty())
+            throw std::invalid_argument("JWT key set entry requires \"alg\" and \"pem\"");
+
+        auto kid = getString("kid");
+        dbg(COLOR_BG_BLUE << "JwtAuthorizer key kid=" << kid << " alg=" << alg);
+        if (!keySet.emplace(std::move(kid), createVerifier(alg, pem)).second)
+            throw std::invalid_argument("JWT key set contains duplicated \"kid\"");
+    }
+
+    return keySet;
+}
+
+std::filesystem::path JwtAuthorizer::defaultKeySetPath()
+{
+    auto selfPath = std::filesystem::read_symlink("/proc/self/exe");
+    return std::filesystem::path(selfPath).remove_filename() / KEY_SET_PATH;
+}
+
 JwtAuthorizer::Verifier JwtAuthorizer::createDefaultVerifier()
 {
     /*
@@ -67,11 +172,25 @@ const std::shared_ptr<const ClientPermissions> JwtAuthorizer::authorize(const st
         return m_emptyClientPermissions;
     }
 
+    reloadKeySetIfChanged();
+
+    if (auto permissions = findCachedToken(token))
+        return permissions;
+
     try
     {
         auto decoded = jwt::decode(token);
 
-        m_jwtVerifier.verify(decoded);
+        const auto keySet = std::atomic_load_explicit(&m_keySet, std::memory_order_acquire);
+        const auto kid = decoded.has_key_id() ? decoded.get_key_id() : std::string();
+        auto verifier = keySet->find(kid);
+        // a single key without "kid" (ie: the Verifier constructor) verifies every token
+        if (verifier == keySet->cend() && keySet->size() == 1 && keySet->cbegin()->first.empty())
+            verifier = keySet->cbegin();
+        if (verifier == keySet->cend())
+            throw InvalidToken("Unknown key id: " + kid);
+
+        verifier->second.verify(decoded);
 
         picojson::value claims;
         picojson::parse(claims, decoded.get_payload());
@@ -80,13 +199,12 @@ const std::shared_ptr<const ClientPermissions> JwtAuthorizer::authorize(const st
             throw InvalidToken("Token claims are not in a valid format");
         }
 
-        auto permissions = std::make_shared<ClientPermissions>();
+        std::set<ClientPermissions::Key> permissions;
         for (auto& e : claims.get<picojson::object>())
         {
             if (e.first == PERMISSIONS_CLAIM)
             {
                 dbg(COLOR_BLUE << "JwtAuthorizer: " << e.first << " = " << e.second);
-                // TODO: cache claims, the same set will result in the same client permissions
                 if (!e.second.is<picojson::array>())
                 {
                     throw InvalidToken("Token claims permissions is not an array");
@@ -106,15 +224,22 @@ const std::shared_ptr<const ClientPermissions> JwtAuthorizer::authorize(const st
                             dbg("Ignored unknown client permission: " << permission);
                             continue;
                         }
-                        permissions->insert(itr->second);
+                        permissions.insert(itr->second);
                     }
                     else
                     {
                         ClientPermissions::Key permission = item.get<double>();
-                        permissions->insert(permission);
+                        permissions.insert(permission);
                     }
                 }
-                return permissions;
+
+                auto clientPermissions = intern(std::move(permissions));
+                cacheToken(token,
+                    clientPermissions,
+                    decoded.has_expires_at() ? decoded.get_expires_at()
+                                             : std::chrono::system_clock::time_point::max(),
+                    keySet);
+                return clientPermissions;
             }
         }
         throw InvalidToken("Token claims do not contain permissions");
@@ -128,3 +253,135 @@ const std::shared_ptr<const ClientPermissions> JwtAuthorizer::authorize(const st
         throw InvalidToken(ex.what());
     }
 }
+
+size_t JwtAuthorizer::cachedTokenCount() const
+{
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+    return m_tokenCache.size();
+}
+
+size_t JwtAuthorizer::internedPermissionsCount() const
+{
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+    return m_internedPermissions.size();
+}
+
+std::shared_ptr<const ClientPermissions> JwtAuthorizer::findCachedToken(const std::string& token)
+{
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+    auto itr = m_tokenCacheIndex.find(token);
+    if (itr == m_tokenCacheIndex.end())
+        return nullptr;
+
+    auto entry = itr->second;
+    if (entry->second.expiresAt <= std::chrono::system_clock::now())
+    {
+        // verify again, so the client gets the proper error
+        m_tokenCacheIndex.erase(itr);
+        m_tokenCache.erase(entry);
+        return nullptr;
+    }
+
+    m_tokenCache.splice(m_tokenCache.begin(), m_tokenCache, entry);
+    return entry->second.permissions;
+}
+
+void JwtAuthorizer::cacheToken(const std::string& token,
+    const std::shared_ptr<const ClientPermissions>& permissions,
+    std::chrono::system_clock::time_point expiresAt,
+    const std::shared_ptr<const JwtAuthorizer::KeySet>& keySet)
+{
+    if (m_cacheCapacity == 0)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+    if (std::atomic_load_explicit(&m_keySet, std::memory_order_acquire) != keySet)
+        return; // verified with keys that were replaced meanwhile
+    if (m_tokenCacheIndex.find(token) != m_tokenCacheIndex.end())
+        return; // verified concurrently
+
+    m_tokenCache.emplace_front(token, CachedToken { permissions, expiresAt });
+    m_tokenCacheIndex.emplace(m_tokenCache.front().first, m_tokenCache.begin());
+
+    while (m_tokenCache.size() > m_cacheCapacity)
+    {
+        m_tokenCacheIndex.erase(m_tokenCache.back().first);
+        m_tokenCache.pop_back();
+    }
+}
+
+std::shared_ptr<const ClientPermissions> JwtAuthorizer::intern(
+    std::set<ClientPermissions::Key>&& permissions)
+{
+    std::vector<ClientPermissions::Key> key(permissions.begin(), permissions.end());
+
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+    auto itr = m_internedPermissions.find(key);
+    if (itr != m_internedPermissions.end())
+    {
+        if (auto clientPermissions = itr->second.lock())
+            return clientPermissions;
+    }
+
+    auto clientPermissions = std::make_shared<ClientPermissions>();
+    for (const auto& permission : permissions)
+        clientPermissions->insert(permission);
+
+    // drop the sets no longer used by any client or cached token. The threshold
+    // doubles with the sets still in use, so pruning is amortized O(1).
+    if (m_internedPermissions.size() >= m_internPruneSize)
+    {
+        for (auto other = m_internedPermissions.begin(); other != m_internedPermissions.end();)
+        {
+            if (other->second.expired())
+                other = m_internedPermissions.erase(other);
+            else
+                ++other;
+        }
+        m_internPruneSize = std::max(MIN_INTERN_PRUNE_SIZE, 2 * m_internedPermissions.size());
+    }
+
+    m_internedPermissions[std::move(key)] = clientPermissions;
+    return clientPermissions;
+}
+
+void JwtAuthorizer::reloadKeySetIfChanged()
+{
+    if (m_keySetPath.empty())
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now.time_since_epoch().count() < m_keySetNextCheck.load(std::memory_order_relaxed))
+        return;
+
+    // a single thread checks, the others keep using the current keys
+    std::unique_lock<std::mutex> lock(m_keySetLock, std::try_to_lock);
+    if (!lock)
+        return;
+    m_keySetNextCheck.store(
+        (now + m_keySetCheckInterval).time_since_epoch().count(), std::memory_order_relaxed);
+
+    std::error_code ec;
+    const auto writeTime = std::filesystem::last_write_time(m_keySetPath, ec);
+    if (ec || writeTime == m_keySetWriteTime)
+        return;
+
+    std::shared_ptr<const KeySet> keySet;
+    try
+    {
+        keySet = std::make_shared<const KeySet>(loadKeySet(m_keySetPath));
+    }
+    catch (std::exception& ex)
+    {
+        // possibly being written, keep the current keys and try again later
+        dbg(COLOR_BG_BLUE << "JwtAuthorizer failed to reload key set: " << ex.what());
+        return;
+    }
+    m_keySetWriteTime = writeTime;
+
+    std::lock_guard<std::mutex> guard(m_cacheLock);
+    std::atomic_store_explicit(&m_keySet, std::move(keySet), std::memory_order_release);
+    // tokens signed by removed keys must be verified again
+    m_tokenCache.clear();
+    m_tokenCacheIndex.clear();
+}
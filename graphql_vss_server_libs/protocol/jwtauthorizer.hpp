@@ -17,9 +17,15 @@
 #include <picojson/picojson.h>
 #include <filesystem>
 
+#include <atomic>
+#include <chrono>
 #include <list>
+#include <map>
 #include <mutex>
+#include <set>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "authorizer.hpp"
 
@@ -29,9 +35,24 @@ class GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT JwtAuthorizer : public Authorizer
 {
 public:
     using Verifier = jwt::verifier<jwt::default_clock, jwt::picojson_traits>;
+    // Verifiers selected by the token "kid" header, tokens without it use the "" entry.
+    // If that's the only entry, it's used for every token.
+    typedef std::unordered_map<std::string, Verifier> KeySet;
+
+    // Verified tokens are cached (up to cacheCapacity, until they expire), so
+    // the signature is verified once per token and not once per request
     GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT
     JwtAuthorizer(Verifier&& jwtVerifier,
-        std::unordered_map<std::string_view, ClientPermissions::Key>&& knownPermissions);
+        std::unordered_map<std::string_view, ClientPermissions::Key>&& knownPermissions,
+        size_t cacheCapacity = DEFAULT_CACHE_CAPACITY);
+
+    // Keys are loaded from a JWKS-style file (see loadKeySet()), which is reloaded when its
+    // modification time changes, checked at most once per keySetCheckInterval.
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT
+    JwtAuthorizer(const std::filesystem::path& keySetPath,
+        std::unordered_map<std::string_view, ClientPermissions::Key>&& knownPermissions,
+        size_t cacheCapacity = DEFAULT_CACHE_CAPACITY,
+        std::chrono::milliseconds keySetCheckInterval = DEFAULT_KEY_SET_CHECK_INTERVAL);
 
     JwtAuthorizer(JwtAuthorizer const&) = delete;
     JwtAuthorizer(JwtAuthorizer&&) = delete;
@@ -50,13 +71,67 @@ public:
     // loads public key relative to executable location (dir) + PUB_KEY_PATH
     GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT static Verifier createDefaultVerifier();
 
+    // algorithm is the JWS "alg": RS256, RS384, RS512, PS256, PS384, PS512, ES256, ES384, ES512
+    // or EdDSA (Ed25519). pubKey is PEM encoded.
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT static Verifier
+    createVerifier(const std::string& algorithm, const std::string& pubKey);
+
+    // { "keys": [ { "kid": "2021-06", "alg": "ES256", "pem": "-----BEGIN PUBLIC KEY-----..." } ] }
+    // "kid" is optional, keys without it verify tokens without "kid".
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT static KeySet loadKeySet(
+        const std::filesystem::path& path);
+
+    // executable location (dir) + KEY_SET_PATH
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT static std::filesystem::path defaultKeySetPath();
+
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT size_t cachedTokenCount() const;
+    // distinct permission sets, including the ones no longer used and not pruned yet
+    GRAPHQL_VSS_SERVER_LIBS_PROTOCOL_EXPORT size_t internedPermissionsCount() const;
+
 private:
-    const Verifier m_jwtVerifier;
+    // replaced as a whole on reload, use std::atomic_load()/std::atomic_store()
+    std::shared_ptr<const KeySet> m_keySet;
+    const std::filesystem::path m_keySetPath;
+    const std::chrono::steady_clock::duration m_keySetCheckInterval;
+    std::atomic<std::chrono::steady_clock::rep> m_keySetNextCheck;
+    std::mutex m_keySetLock;
+    std::filesystem::file_time_type m_keySetWriteTime; // guarded by m_keySetLock
+
     const std::unordered_map<std::string_view, ClientPermissions::Key> m_knownPermissions;
 
     const std::shared_ptr<const ClientPermissions> m_emptyClientPermissions;
-    // TODO: LRU cache with string PERMISSIONS_CLAIM => shared_ptr<ClientPermissions>
 
+    struct CachedToken
+    {
+        std::shared_ptr<const ClientPermissions> permissions;
+        std::chrono::system_clock::time_point expiresAt;
+    };
+    typedef std::list<std::pair<std::string, CachedToken>> TokenCache;
+
+    const size_t m_cacheCapacity;
+    mutable std::mutex m_cacheLock;
+    // LRU: most recently used first, the index keys point to the list strings
+    TokenCache m_tokenCache;
+    std::unordered_map<std::string_view, TokenCache::iterator> m_tokenCacheIndex;
+    // Same set of permissions => same ClientPermissions pointer
+    std::map<std::vector<ClientPermissions::Key>, std::weak_ptr<const ClientPermissions>>
+        m_internedPermissions;
+    size_t m_internPruneSize = MIN_INTERN_PRUNE_SIZE;
+
+    std::shared_ptr<const ClientPermissions> findCachedToken(const std::string& token);
+    void cacheToken(const std::string& token,
+        const std::shared_ptr<const ClientPermissions>& permissions,
+        std::chrono::system_clock::time_point expiresAt,
+        const std::shared_ptr<const KeySet>& keySet);
+    std::shared_ptr<const ClientPermissions> intern(std::set<ClientPermissions::Key>&& permissions);
+
+    static constexpr size_t DEFAULT_CACHE_CAPACITY = 1024;
+    static constexpr size_t MIN_INTERN_PRUNE_SIZE = 64;
+    void reloadKeySetIfChanged();
+
+    static constexpr std::chrono::milliseconds DEFAULT_KEY_SET_CHECK_INTERVAL =
+        std::chrono::seconds(1);
     static constexpr std::string_view PUB_KEY_PATH = "keys/jwtRS256.key.pub";
+    static constexpr std::string_view KEY_SET_PATH = "keys/jwks.json";
     static constexpr std::string_view PERMISSIONS_CLAIM = "permissions";
 };
@@ -0,0 +1,392 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include <poll.h>
+
+#include <boost/asio/post.hpp>
+
+#include "debug.hpp"
+
+#include "commonapi-mainloop.hpp"
+
+std::shared_ptr<CommonAPIAsioMainLoop> CommonAPIAsioMainLoop::create(
+    boost::asio::io_context& ioContext, const std::string& name)
+{
+    auto mainLoop = std::make_shared<CommonAPIAsioMainLoop>(ioContext, name);
+    // callbacks reference it weakly, so it must be subscribed after it's shared
+    mainLoop->subscribe();
+    return mainLoop;
+}
+
+CommonAPIAsioMainLoop::CommonAPIAsioMainLoop(
+    boost::asio::io_context& ioContext, const std::string& name)
+    : m_ioContext(ioContext)
+    , m_context(std::make_shared<CommonAPI::MainLoopContext>(name))
+    , m_dispatchTimer(ioContext)
+{
+}
+
+CommonAPIAsioMainLoop::~CommonAPIAsioMainLoop()
+{
+    m_context->unsubscribeForDispatchSources(m_dispatchSourcesSubscription);
+    m_context->unsubscribeForWatches(m_watchesSubscription);
+    m_context->unsubscribeForTimeouts(m_timeoutsSubscription);
+    m_context->unsubscribeForWakeupEvents(m_wakeupSubscription);
+
+    std::lock_guard guard(m_lock);
+    for (auto& itr : m_watches)
+        itr.second->descriptor.release(); // owned by CommonAPI
+    m_watches.clear();
+    m_timeouts.clear();
+    m_dispatchSources.clear();
+}
+
+void CommonAPIAsioMainLoop::subscribe()
+{
+    std::weak_ptr<CommonAPIAsioMainLoop> weak = shared_from_this();
+
+    m_dispatchSourcesSubscription = m_context->subscribeForDispatchSources(
+        [weak](CommonAPI::DispatchSource* source, const CommonAPI::DispatchPriority priority) {
+            if (auto self = weak.lock())
+                self->addDispatchSource(source, priority);
+        },
+        [weak](CommonAPI::DispatchSource* source) {
+            if (auto self = weak.lock())
+                self->removeDispatchSource(source);
+        });
+
+    m_watchesSubscription = m_context->subscribeForWatches(
+        [weak](CommonAPI::Watch* watch, const CommonAPI::DispatchPriority) {
+            if (auto self = weak.lock())
+                self->addWatch(watch);
+        },
+        [weak](CommonAPI::Watch* watch) {
+            if (auto self = weak.lock())
+                self->removeWatch(watch);
+        });
+
+    m_timeoutsSubscription = m_context->subscribeForTimeouts(
+        [weak](CommonAPI::Timeout* timeout, const CommonAPI::DispatchPriority) {
+            if (auto self = weak.lock())
+                self->addTimeout(timeout);
+        },
+        [weak](CommonAPI::Timeout* timeout) {
+            if (auto self = weak.lock())
+                self->removeTimeout(timeout);
+        });
+
+    m_wakeupSubscription = m_context->subscribeForWakeupEvents([weak]() {
+        if (auto self = weak.lock())
+            self->scheduleDispatch();
+    });
+}
+
+void CommonAPIAsioMainLoop::beginDispatch(const void* source)
+{
+    m_dispatching.insert({ source, std::this_thread::get_id() });
+}
+
+void CommonAPIAsioMainLoop::endDispatch(const void* source)
+{
+    auto range = m_dispatching.equal_range(source);
+    for (auto itr = range.first; itr != range.second; ++itr)
+    {
+        if (itr->second == std::this_thread::get_id())
+        {
+            m_dispatching.erase(itr);
+            break;
+        }
+    }
+    m_dispatchFinished.notify_all();
+}
+
+void CommonAPIAsioMainLoop::waitDispatch(
+    std::unique_lock<std::recursive_mutex>& guard, const void* source)
+{
+    // a source removed by its own dispatch can't be waited
+    m_dispatchFinished.wait(guard, [this, source]() {
+        auto range = m_dispatching.equal_range(source);
+        for (auto itr = range.first; itr != range.second; ++itr)
+        {
+            if (itr->second != std::this_thread::get_id())
+                return false;
+        }
+        return true;
+    });
+}
+
+bool CommonAPIAsioMainLoop::claimDispatchSource(CommonAPI::DispatchSource* source)
+{
+    if (m_dispatching.count(source) > 0)
+    {
+        m_redispatch.insert(source);
+        return false;
+    }
+    beginDispatch(source);
+    return true;
+}
+
+void CommonAPIAsioMainLoop::releaseDispatchSource(CommonAPI::DispatchSource* source)
+{
+    endDispatch(source);
+    if (m_redispatch.erase(source) > 0)
+        scheduleDispatch();
+}
+
+void CommonAPIAsioMainLoop::addDispatchSource(
+    CommonAPI::DispatchSource* source, CommonAPI::DispatchPriority priority)
+{
+    std::lock_guard guard(m_lock);
+    m_dispatchSources.insert({ priority, source });
+    scheduleDispatch();
+}
+
+void CommonAPIAsioMainLoop::removeDispatchSource(CommonAPI::DispatchSource* source)
+{
+    std::unique_lock guard(m_lock);
+    waitDispatch(guard, source);
+    m_redispatch.erase(source);
+    for (auto itr = m_dispatchSources.begin(); itr != m_dispatchSources.end(); ++itr)
+    {
+        if (itr->second == source)
+        {
+            m_dispatchSources.erase(itr);
+            return;
+        }
+    }
+}
+
+void CommonAPIAsioMainLoop::scheduleDispatch()
+{
+    std::lock_guard guard(m_lock);
+    if (m_dispatchScheduled)
+        return;
+    m_dispatchScheduled = true;
+
+    boost::asio::post(m_ioContext, [weak = weak_from_this()]() {
+        if (auto self = weak.lock())
+            self->dispatchSources();
+    });
+}
+
+void CommonAPIAsioMainLoop::dispatchSources()
+{
+    std::unique_lock guard(m_lock);
+    m_dispatchScheduled = false;
+
+    // same steps as CommonAPI::MainLoop: prepare, check and dispatch by priority.
+    int64_t nextTimeout = -1;
+    std::vector<CommonAPI::DispatchSource*> ready;
+    for (auto& itr : m_dispatchSources)
+    {
+        // sources aren't thread safe, another io thread may be dispatching it
+        if (m_dispatching.count(itr.second) > 0)
+        {
+            m_redispatch.insert(itr.second);
+            continue;
+        }
+
+        int64_t timeout = -1;
+        if (itr.second->prepare(timeout) || itr.second->check())
+        {
+            ready.push_back(itr.second);
+            beginDispatch(itr.second);
+        }
+        else if (timeout >= 0 && (nextTimeout < 0 || timeout < nextTimeout))
+            nextTimeout = timeout;
+    }
+
+    for (auto source : ready)
+    {
+        // dispatching a source may remove the next ones from this thread
+        bool registered = false;
+        for (auto& itr : m_dispatchSources)
+            registered = registered || itr.second == source;
+        if (registered)
+        {
+            guard.unlock();
+            while (source->dispatch())
+            {
+            }
+            guard.lock();
+        }
+        releaseDispatchSource(source);
+    }
+
+    if (nextTimeout >= 0)
+    {
+        m_dispatchTimer.expires_after(std::chrono::milliseconds(nextTimeout));
+        m_dispatchTimer.async_wait([weak = weak_from_this()](const boost::system::error_code& ec) {
+            if (ec)
+                return;
+            if (auto self = weak.lock())
+                self->scheduleDispatch();
+        });
+    }
+}
+
+void CommonAPIAsioMainLoop::addWatch(CommonAPI::Watch* watch)
+{
+    std::lock_guard guard(m_lock);
+    auto state = std::make_unique<WatchState>(WatchState {
+        boost::asio::posix::stream_descriptor(
+            m_ioContext, watch->getAssociatedFileDescriptor().fd),
+        0,
+    });
+    waitWatch(watch, *state);
+    m_watches[watch] = std::move(state);
+}
+
+void CommonAPIAsioMainLoop::removeWatch(CommonAPI::Watch* watch)
+{
+    std::unique_lock guard(m_lock);
+    waitDispatch(guard, watch);
+    auto itr = m_watches.find(watch);
+    if (itr == m_watches.end())
+        return;
+
+    boost::system::error_code ec;
+    itr->second->descriptor.cancel(ec);
+    itr->second->descriptor.release(); // owned by CommonAPI
+    m_watches.erase(itr);
+}
+
+void CommonAPIAsioMainLoop::waitWatch(CommonAPI::Watch* watch, WatchState& state)
+{
+    // asio waits one condition at a time, a watch requesting both POLLIN and
+    // POLLOUT waits twice and the first to complete dispatches. The other
+    // completes with a stale generation and is ignored.
+    state.generation = ++m_generation;
+    auto onReady = [weak = weak_from_this(), watch, generation = state.generation](
+                       const boost::system::error_code& ec) {
+        if (ec)
+            return;
+        if (auto self = weak.lock())
+            self->dispatchWatch(watch, generation);
+    };
+
+    auto events = watch->getAssociatedFileDescriptor().events;
+    if (events & POLLOUT)
+        state.descriptor.async_wait(boost::asio::posix::stream_descriptor::wait_write, onReady);
+    if ((events & POLLIN) || !(events & POLLOUT))
+        state.descriptor.async_wait(boost::asio::posix::stream_descriptor::wait_read, onReady);
+}
+
+void CommonAPIAsioMainLoop::dispatchWatch(CommonAPI::Watch* watch, uint64_t generation)
+{
+    std::unique_lock guard(m_lock);
+    auto itr = m_watches.find(watch);
+    // the pointer may have been reused by another watch
+    if (itr == m_watches.end() || itr->second->generation != generation)
+        return;
+
+    // claim it, so the other wait (if any) is ignored
+    generation = ++m_generation;
+    itr->second->generation = generation;
+    boost::system::error_code ec;
+    itr->second->descriptor.cancel(ec);
+
+    pollfd ready = watch->getAssociatedFileDescriptor();
+    ready.revents = 0;
+    beginDispatch(watch);
+    guard.unlock();
+
+    // asio doesn't tell which events are ready, ask the kernel
+    if (poll(&ready, 1, 0) > 0 && ready.revents != 0)
+    {
+        watch->dispatch(ready.revents);
+
+        guard.lock();
+        itr = m_watches.find(watch);
+        if (itr == m_watches.end() || itr->second->generation != generation)
+        {
+            endDispatch(watch);
+            return; // removed while dispatching
+        }
+        guard.unlock();
+
+        for (auto source : watch->getDependentDispatchSources())
+        {
+            guard.lock();
+            bool claimed = claimDispatchSource(source);
+            guard.unlock();
+            if (!claimed)
+                continue;
+
+            while (source->check() && source->dispatch())
+            {
+            }
+
+            guard.lock();
+            releaseDispatchSource(source);
+            guard.unlock();
+        }
+    }
+
+    guard.lock();
+    endDispatch(watch);
+
+    itr = m_watches.find(watch);
+    if (itr != m_watches.end() && itr->second->generation == generation)
+        waitWatch(watch, *itr->second);
+}
+
+void CommonAPIAsioMainLoop::addTimeout(CommonAPI::Timeout* timeout)
+{
+    std::lock_guard guard(m_lock);
+    auto state = std::make_unique<TimeoutState>(TimeoutState {
+        boost::asio::steady_timer(m_ioContext),
+        ++m_generation,
+    });
+    waitTimeout(timeout, *state);
+    m_timeouts[timeout] = std::move(state);
+}
+
+void CommonAPIAsioMainLoop::removeTimeout(CommonAPI::Timeout* timeout)
+{
+    std::unique_lock guard(m_lock);
+    waitDispatch(guard, timeout);
+    m_timeouts.erase(timeout); // cancels the timer
+}
+
+void CommonAPIAsioMainLoop::waitTimeout(CommonAPI::Timeout* timeout, TimeoutState& state)
+{
+    state.timer.expires_after(std::chrono::milliseconds(timeout->getTimeoutInterval()));
+    state.timer.async_wait([weak = weak_from_this(), timeout, generation = state.generation](
+                               const boost::system::error_code& ec) {
+        if (ec)
+            return;
+        if (auto self = weak.lock())
+            self->dispatchTimeout(timeout, generation);
+    });
+}
+
+void CommonAPIAsioMainLoop::dispatchTimeout(CommonAPI::Timeout* timeout, uint64_t generation)
+{
+    std::unique_lock guard(m_lock);
+    auto itr = m_timeouts.find(timeout);
+    if (itr == m_timeouts.end() || itr->second->generation != generation)
+        return;
+
+    beginDispatch(timeout);
+    guard.unlock();
+
+    timeout->dispatch();
+
+    guard.lock();
+    endDispatch(timeout);
+
+    itr = m_timeouts.find(timeout);
+    if (itr != m_timeouts.end() && itr->second->generation == generation)
+        waitTimeout(timeout, *itr->second);
+}
@@ -0,0 +1,129 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <CommonAPI/CommonAPI.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "graphql_vss_server_libs-support_export.h"
+
+// Drives a CommonAPI::MainLoopContext from an asio io_context, so CommonAPI
+// callbacks run in the io_context threads (ie: the server main thread) instead
+// of the CommonAPI/vsomeip dispatcher threads. To use it, set it before the
+// first proxy is created:
+//
+//   auto mainLoop = CommonAPIAsioMainLoop::create(ioContext);
+//   commonAPISingletonProxyMainLoopContext = mainLoop->context();
+//
+// Keep mainLoop alive while the proxies are alive. To control the dispatch
+// concurrency, give it a dedicated io_context and run it in as many threads as
+// desired.
+class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT CommonAPIAsioMainLoop
+    : public std::enable_shared_from_this<CommonAPIAsioMainLoop>
+{
+public:
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT static std::shared_ptr<CommonAPIAsioMainLoop> create(
+        boost::asio::io_context& ioContext, const std::string& name = "graphql");
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ~CommonAPIAsioMainLoop();
+
+    CommonAPIAsioMainLoop(CommonAPIAsioMainLoop const&) = delete;
+    CommonAPIAsioMainLoop(CommonAPIAsioMainLoop&&) = delete;
+
+    inline const std::shared_ptr<CommonAPI::MainLoopContext>& context() const
+    {
+        return m_context;
+    }
+
+    // used by create(), use that instead
+    CommonAPIAsioMainLoop(boost::asio::io_context& ioContext, const std::string& name);
+
+private:
+    struct WatchState
+    {
+        boost::asio::posix::stream_descriptor descriptor;
+        uint64_t generation; // changes on every wait, see waitWatch()
+    };
+
+    struct TimeoutState
+    {
+        boost::asio::steady_timer timer;
+        uint64_t generation;
+    };
+
+    boost::asio::io_context& m_ioContext;
+    std::shared_ptr<CommonAPI::MainLoopContext> m_context;
+
+    // CommonAPI adds and removes sources from any thread and may delete them
+    // right after removing. They are dispatched without the lock, so CommonAPI
+    // may add or remove sources meanwhile, but marked in m_dispatching: other
+    // threads removing them wait for the dispatch to finish.
+    std::recursive_mutex m_lock;
+    std::condition_variable_any m_dispatchFinished;
+    std::multimap<const void*, std::thread::id> m_dispatching;
+    // Sources found ready while another thread dispatched them, they are never
+    // dispatched concurrently: the thread dispatching schedules them again.
+    std::set<const void*> m_redispatch;
+    std::multimap<CommonAPI::DispatchPriority, CommonAPI::DispatchSource*> m_dispatchSources;
+    std::map<CommonAPI::Watch*, std::unique_ptr<WatchState>> m_watches;
+    std::map<CommonAPI::Timeout*, std::unique_ptr<TimeoutState>> m_timeouts;
+    boost::asio::steady_timer m_dispatchTimer;
+    bool m_dispatchScheduled = false;
+    uint64_t m_generation = 0;
+
+    CommonAPI::DispatchSourceListenerSubscription m_dispatchSourcesSubscription;
+    CommonAPI::WatchListenerSubscription m_watchesSubscription;
+    CommonAPI::TimeoutSourceListenerSubscription m_timeoutsSubscription;
+    CommonAPI::WakeupListenerSubscription m_wakeupSubscription;
+
+    void subscribe();
+
+    // m_lock must be held by the caller
+    void beginDispatch(const void* source);
+    void endDispatch(const void* source);
+    // guard must hold m_lock once, it's released while waiting
+    void waitDispatch(std::unique_lock<std::recursive_mutex>& guard, const void* source);
+
+    // m_lock must be held by the caller. Returns false if another thread is
+    // dispatching the source, it's dispatched again once that thread is done.
+    bool claimDispatchSource(CommonAPI::DispatchSource* source);
+    void releaseDispatchSource(CommonAPI::DispatchSource* source);
+
+    void addDispatchSource(CommonAPI::DispatchSource* source, CommonAPI::DispatchPriority priority);
+    void removeDispatchSource(CommonAPI::DispatchSource* source);
+    void scheduleDispatch();
+    void dispatchSources();
+
+    void addWatch(CommonAPI::Watch* watch);
+    void removeWatch(CommonAPI::Watch* watch);
+    void waitWatch(CommonAPI::Watch* watch, WatchState& state);
+    void dispatchWatch(CommonAPI::Watch* watch, uint64_t generation);
+
+    void addTimeout(CommonAPI::Timeout* timeout);
+    void removeTimeout(CommonAPI::Timeout* timeout);
+    void waitTimeout(CommonAPI::Timeout* timeout, TimeoutState& state);
+    void dispatchTimeout(CommonAPI::Timeout* timeout, uint64_t generation);
+};
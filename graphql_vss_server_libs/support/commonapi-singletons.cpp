@@ -19,3 +19,7 @@
 std::shared_ptr<CommonAPI::Runtime> commonAPISingletonProxyRuntime = CommonAPI::Runtime::get();
 std::string commonAPISingletonProxyConnectionId(GRAPHQL_SOMEIP_NAME);
 std::string commonAPISingletonProxyDomain("local");
+std::shared_ptr<CommonAPI::MainLoopContext> commonAPISingletonProxyMainLoopContext;
+std::chrono::milliseconds commonAPISingletonProxyAvailabilityTimeout(5000);
+std::shared_ptr<Executor> commonAPISingletonNotificationExecutor =
+    std::make_shared<ThreadPoolExecutor>(1);
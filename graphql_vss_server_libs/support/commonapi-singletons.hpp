@@ -14,11 +14,21 @@
 #pragma once
 #include <graphqlservice/GraphQLService.h>
 #include <CommonAPI/CommonAPI.hpp>
-#include <boost/signals2.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <list>
 #include <optional>
+#include <unordered_map>
 
 #include "demangle.hpp"
+#include "eventstore.hpp"
+#include "executor.hpp"
+#include "mempool.hpp"
+#include "observers.hpp"
 #include "singleton.hpp"
+#include "timer.hpp"
 #include "spinlock.hpp"
 #include "type_traits_extras.hpp"
 #include "log.hpp"
@@ -26,7 +36,9 @@
 
 #include "graphql_vss_server_libs-support_export.h"
 
+#ifndef SUBSCRIPTION_TIMEOUT_SECONDS
 #define SUBSCRIPTION_TIMEOUT_SECONDS 5
+#endif
 
 using namespace graphql;
 
@@ -34,6 +46,65 @@ extern GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::shared_ptr<CommonAPI::Runtime
     commonAPISingletonProxyRuntime;
 extern GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::string commonAPISingletonProxyConnectionId;
 extern GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::string commonAPISingletonProxyDomain;
+// If set, proxies are built with this main loop context instead of
+// commonAPISingletonProxyConnectionId, see CommonAPIAsioMainLoop
+extern GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::shared_ptr<CommonAPI::MainLoopContext>
+    commonAPISingletonProxyMainLoopContext;
+// How long CommonAPIProxy waits for the service to become available
+extern GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::chrono::milliseconds
+    commonAPISingletonProxyAvailabilityTimeout;
+// Signals attributes with Options::offloadEmission, it must run tasks in order
+// (defaults to a single thread)
+extern GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::shared_ptr<Executor>
+    commonAPISingletonNotificationExecutor;
+
+// Per attribute options. Defaults are used unless CommonAPIAttributeOptions is
+// specialized for the attribute getter, see COMMONAPI_ATTRIBUTE_OPTIONS()
+struct CommonAPIDefaultAttributeOptions
+{
+    // How long subscription attributes wait for the first value after subscribing
+    static constexpr std::chrono::milliseconds subscriptionTimeout =
+        std::chrono::seconds(SUBSCRIPTION_TIMEOUT_SECONDS);
+
+    // Maximum number of events kept by accumulative attributes, 0 is unlimited
+    static constexpr size_t accumulativeCapacity = 0;
+
+    // Released broadcast events kept for reuse by the attribute, 0 allocates
+    // every event with std::make_shared()
+    static constexpr size_t eventPoolSize = 0;
+
+    // Cached attributes don't publish nor signal values equal to the current one,
+    // useful for ECUs cyclically re-sending unchanged values
+    static constexpr bool suppressUnchanged = false;
+
+    // With suppressUnchanged, floating point values within this distance from the
+    // last published one are considered unchanged
+    static constexpr double deadband = 0.0;
+
+    // Cached attributes signal at most once per interval: the first change is
+    // signaled right away, changes within the interval are coalesced into a
+    // single signal of the latest value at the end of it. Zero disables it.
+    static constexpr std::chrono::milliseconds minEmitInterval = std::chrono::milliseconds(0);
+
+    // Cached attributes only publish the new value in the CommonAPI dispatcher
+    // thread, observers are signaled by commonAPISingletonNotificationExecutor.
+    // Changes arriving before the signal is delivered are coalesced.
+    static constexpr bool offloadEmission = false;
+};
+
+template <auto TGetAttribute>
+struct CommonAPIAttributeOptions : public CommonAPIDefaultAttributeOptions
+{
+};
+
+template <typename TOptions, typename TValue>
+inline bool commonAPIValueUnchanged(const TValue& previous, const TValue& current)
+{
+    if constexpr (std::is_floating_point_v<TValue>)
+        return std::abs(current - previous) <= TOptions::deadband;
+    else
+        return previous == current;
+}
 
 template <typename AttributeGetterPointer>
 struct CommonAPIProxyAttributeGetterTraits
@@ -88,52 +159,14 @@ struct CommonAPIProxy
 
     std::shared_ptr<Proxy> proxy;
 
-    static std::shared_ptr<Self> create()
-    {
-        std::shared_ptr<Proxy> proxy =
-            commonAPISingletonProxyRuntime->buildProxy<ProxyClass_>(commonAPISingletonProxyDomain,
-                std::string(instanceId),
-                commonAPISingletonProxyConnectionId);
-
-        if (proxy == nullptr)
-        {
-            std::ostringstream msg;
-            msg << "ERROR: Problem while creating proxy '" << demangle<Proxy>() << "', instance: '"
-                << instanceId << "', domain: '" << commonAPISingletonProxyDomain
-                << "', connectionId: '" << commonAPISingletonProxyConnectionId << "'";
-#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_DEBUG
-            msg << ", symbol: " << demangle<Proxy>();
-#endif
-            DLT_LOG(dltCommonAPI,
-                DLT_LOG_ERROR,
-                DLT_UTF8(msg.str().c_str()));
-            throw std::runtime_error(msg.str());
-        }
-
-        for (size_t retries = 0; retries < 1e5 && !proxy->isAvailable(); retries++)
-            std::this_thread::sleep_for(std::chrono::microseconds(5));
-
-        if (!proxy->isAvailable())
-        {
-            std::ostringstream msg;
-            msg << "ERROR: Proxy couldn't be available: proxy '" << demangle<Proxy>()
-                << "', instance: '" << instanceId << "', domain: '" << commonAPISingletonProxyDomain
-                << "', connectionId: '" << commonAPISingletonProxyConnectionId << "'";
-#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_DEBUG
-            msg << ", symbol: " << demangle<Proxy>();
-#endif
-            DLT_LOG(dltCommonAPI,
-                    DLT_LOG_ERROR,
-                    DLT_UTF8(msg.str().c_str()));
-            throw std::runtime_error(msg.str());
-        }
-
-        return std::make_shared<Self>(std::move(proxy));
-    }
-
-    static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage*)
+    // Building the proxy is quick and runs in the storage executor, then its
+    // availability completes the future: either from the proxy status event or
+    // from the TimerService at commonAPISingletonProxyAvailabilityTimeout. No
+    // thread is blocked waiting for the availability besides the waiters.
+    static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::async, create);
+        return std::async(std::launch::deferred,
+            [built = storage->async(startCreate)]() mutable { return built.get().get(); });
     }
 
     CommonAPIProxy(std::shared_ptr<Proxy>&& proxy)
@@ -168,6 +201,103 @@ struct CommonAPIProxy
                           << this);
         proxy.reset();
     }
+
+private:
+    struct Availability
+    {
+        std::shared_ptr<Proxy> proxy;
+        std::promise<std::shared_ptr<Self>> result;
+        std::atomic<bool> completed = false;
+        typename CommonAPI::ProxyStatusEvent::Subscription subscription;
+
+        void setAvailable()
+        {
+            if (!completed.exchange(true))
+                result.set_value(std::make_shared<Self>(std::shared_ptr<Proxy>(proxy)));
+        }
+
+        void setTimedOut()
+        {
+            if (completed.exchange(true))
+                return;
+
+            std::ostringstream msg;
+            msg << "ERROR: Proxy couldn't be available: proxy '" << demangle<Proxy>()
+                << "', instance: '" << instanceId << "', domain: '" << commonAPISingletonProxyDomain
+                << "', connectionId: '" << commonAPISingletonProxyConnectionId << "'";
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_DEBUG
+            msg << ", symbol: " << demangle<Proxy>();
+#endif
+            DLT_LOG(dltCommonAPI,
+                    DLT_LOG_ERROR,
+                    DLT_UTF8(msg.str().c_str()));
+            result.set_exception(std::make_exception_ptr(std::runtime_error(msg.str())));
+        }
+    };
+
+    static std::shared_future<std::shared_ptr<Self>> startCreate()
+    {
+        auto availability = std::make_shared<Availability>();
+        std::shared_future<std::shared_ptr<Self>> future = availability->result.get_future();
+        availability->proxy = buildProxy();
+
+        if (availability->proxy->isAvailable())
+        {
+            availability->setAvailable();
+            return future;
+        }
+
+        // weak: the proxy keeps the listener, the timer keeps the availability
+        std::weak_ptr<Availability> weak = availability;
+        availability->subscription = availability->proxy->getProxyStatusEvent().subscribe(
+            [weak](const CommonAPI::AvailabilityStatus& status) {
+                if (status != CommonAPI::AvailabilityStatus::AVAILABLE)
+                    return;
+                if (auto availability = weak.lock())
+                    availability->setAvailable();
+            });
+
+        // it may have become available before we subscribed
+        if (availability->proxy->isAvailable())
+            availability->setAvailable();
+
+        TimerService::shared().schedule(commonAPISingletonProxyAvailabilityTimeout,
+            [availability]() {
+                availability->setTimedOut();
+                availability->proxy->getProxyStatusEvent().unsubscribe(
+                    availability->subscription);
+            });
+
+        return future;
+    }
+
+    static std::shared_ptr<Proxy> buildProxy()
+    {
+        std::shared_ptr<Proxy> proxy = commonAPISingletonProxyMainLoopContext
+            ? commonAPISingletonProxyRuntime->buildProxy<ProxyClass_>(commonAPISingletonProxyDomain,
+                std::string(instanceId),
+                commonAPISingletonProxyMainLoopContext)
+            : commonAPISingletonProxyRuntime->buildProxy<ProxyClass_>(commonAPISingletonProxyDomain,
+                std::string(instanceId),
+                commonAPISingletonProxyConnectionId);
+
+        if (proxy == nullptr)
+        {
+            std::ostringstream msg;
+            msg << "ERROR: Problem while creating proxy '" << demangle<Proxy>() << "', instance: '"
+                << instanceId << "', domain: '" << commonAPISingletonProxyDomain
+                << "', connectionId: '" << commonAPISingletonProxyConnectionId << "'";
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_DEBUG
+            msg << ", symbol: " << demangle<Proxy>();
+#endif
+            DLT_LOG(dltCommonAPI,
+                DLT_LOG_ERROR,
+                DLT_UTF8(msg.str().c_str()));
+            throw std::runtime_error(msg.str());
+        }
+
+        return proxy;
+    }
 };
 
 template <typename TValue, typename TProxy, typename TAttribute,
@@ -252,6 +382,53 @@ protected:
         }
         return response;
     }
+
+    // Non-blocking variants of fetchValue() and changeValue(), the returned future is
+    // fulfilled by the CommonAPI dispatcher thread. Many of these may be in flight
+    // at the same time, so a query touching many services waits for the slowest one
+    // instead of the sum of all of them.
+    std::future<Value> fetchValueAsync() const
+    {
+        auto promise = std::make_shared<std::promise<Value>>();
+        auto future = promise->get_future();
+
+        this->m_attribute.getValueAsync(
+            [promise](const CommonAPI::CallStatus& status, Value response) {
+                if (status == CommonAPI::CallStatus::SUCCESS)
+                    promise->set_value(std::move(response));
+                else
+                    promise->set_exception(asyncCallError("Error while fetching for value: "));
+            });
+
+        return future;
+    }
+
+    std::future<Value> changeValueAsync(const Value& input) const
+    {
+        auto promise = std::make_shared<std::promise<Value>>();
+        auto future = promise->get_future();
+
+        this->m_attribute.setValueAsync(input,
+            [promise](const CommonAPI::CallStatus& status, Value response) {
+                if (status == CommonAPI::CallStatus::SUCCESS)
+                    promise->set_value(std::move(response));
+                else
+                    promise->set_exception(asyncCallError("Error while changing value: "));
+            });
+
+        return future;
+    }
+
+private:
+    static std::exception_ptr asyncCallError(const std::string_view& prefix)
+    {
+        std::ostringstream error_message;
+        error_message << prefix << demangle<Self>();
+        DLT_LOG(dltCommonAPI,
+            DLT_LOG_ERROR,
+            DLT_UTF8(error_message.str().c_str()));
+        return std::make_exception_ptr(std::runtime_error(error_message.str()));
+    }
 };
 
 template <typename ValueType, typename LockType>
@@ -274,14 +451,46 @@ private:
     const std::lock_guard<LockType> lock;
 };
 
+// Keeps an immutable snapshot alive while it's used. It exposes the same
+// `value` member as LockedValueReference, but no lock is held.
+template <typename ValueType>
+class SnapshotValueReference
+{
+private:
+    const std::shared_ptr<ValueType> snapshot; // keep before value!
+
+public:
+    ValueType& value;
+
+    explicit SnapshotValueReference(std::shared_ptr<ValueType>&& _snapshot)
+        : snapshot(std::move(_snapshot))
+        , value(*snapshot)
+    {
+    }
+
+    SnapshotValueReference(
+        SnapshotValueReference const& other) = delete;               // avoid copies, it's an usage bug!
+    SnapshotValueReference(SnapshotValueReference&& other) = delete; // avoid copies, it's an usage bug!
+};
+
 // Get the value in getValue or refreshValueUnlocked and then just reuse it
 // NOTE: no changes will ever be applied, to track changes use one of:
 // - CommonAPISubscriptionProxyAttribute
 // or call refreshValue() manually
+//
+// The value is published as an immutable snapshot (RCU-like): writers
+// serialize on `lock` and atomically swap the snapshot pointer, readers just
+// take a reference to the current snapshot and never wait for `lock`, so the
+// CommonAPI dispatcher never waits for a resolver converting the value.
+// Note the std::atomic_load()/std::atomic_store() of a shared_ptr aren't
+// lock-free in libstdc++: they take a mutex from a global pool, held just to
+// copy the pointer.
 template <typename TValue, typename TProxy, typename TAttribute,
     TAttribute& (TProxy::Proxy::*TGetAttribute)()>
 class CommonAPICachedProxyAttribute
     : public CommonAPIBaseProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>
+    , public std::enable_shared_from_this<
+          CommonAPICachedProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>>
 {
 public:
     using typename CommonAPIBaseProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>::Proxy;
@@ -289,9 +498,11 @@ public:
         typename CommonAPIBaseProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>::Attribute;
     using typename CommonAPIBaseProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>::Value;
     typedef CommonAPICachedProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute> Self;
+    typedef std::shared_ptr<const Value> Snapshot;
 
+    // Serializes writers only, readers never take it
     SpinLock lock = SpinLock(this);
-    boost::signals2::signal<void(const Value&)> signal;
+    ObserverList<void(const Value&)> signal;
 
     static std::shared_ptr<Self> create(SingletonStorage* storage)
     {
@@ -300,7 +511,7 @@ public:
 
     static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::async, create, storage);
+        return storage->async(create, storage);
     }
 
     explicit CommonAPICachedProxyAttribute(typename Singleton<Proxy>::Ref&& proxySingleton)
@@ -313,57 +524,156 @@ public:
     CommonAPICachedProxyAttribute(CommonAPICachedProxyAttribute&& other) = delete;
 
     // This will lock internally!
-    const Value& refreshValue()
+    Snapshot refreshValue()
     {
         return this->setValue(this->fetchValue());
     }
 
-    const Value& refreshValueUnlocked()
+    Snapshot refreshValueUnlocked()
     {
-        this->m_value = this->fetchValue();
-        signal(this->m_value);
-        return this->m_value;
+        return this->publishValue(this->fetchValue());
     }
 
-    inline LockedValueReference<const Value, SpinLock> getValue()
+    // Doesn't wait for `lock`, the returned snapshot is immutable and stays
+    // valid even if the attribute is updated meanwhile
+    inline Snapshot getSnapshot() const
     {
-        return LockedValueReference<const Value, SpinLock>(this->m_value, this->lock);
+        return std::atomic_load_explicit(&this->m_snapshot, std::memory_order_acquire);
+    }
+
+    inline SnapshotValueReference<const Value> getValue() const
+    {
+        return SnapshotValueReference<const Value>(this->getSnapshot());
     }
 
     template <typename TConverted>
-    inline TConverted getValue(std::function<TConverted(const Value&)>&& convert)
+    inline TConverted getValue(std::function<TConverted(const Value&)>&& convert) const
     {
-        std::lock_guard<SpinLock> guard(this->lock);
-        return convert(this->m_value);
+        return convert(*this->getSnapshot());
     }
 
     template <typename TConverted>
-    inline TConverted getValue()
+    inline TConverted getValue() const
     {
-        std::lock_guard<SpinLock> guard(this->lock);
-        return TConverted(const_cast<const Value&>(this->m_value));
+        return TConverted(*this->getSnapshot());
     }
 
     inline void mutateValue(const Value& input)
     {
         std::lock_guard<SpinLock> mutation_lock(lock);
-        this->m_value = this->changeValue(input);
-        signal(this->m_value);
+        this->publishValue(this->changeValue(input));
+    }
+
+    // The remote call is started right away, the new value is published when the
+    // returned future is waited (ie: by the resolver). The future keeps the
+    // attribute alive, it may be waited after the singleton was released.
+    std::future<Snapshot> mutateValueAsync(const Value& input)
+    {
+        return std::async(std::launch::deferred,
+            [self = this->shared_from_this(),
+                response = this->changeValueAsync(input)]() mutable {
+                return self->setValue(response.get());
+            });
     }
 
 protected:
-    Value m_value;
+    typedef CommonAPIAttributeOptions<TGetAttribute> Options;
+
+    Snapshot m_snapshot = std::make_shared<const Value>();
 
-    const Value& setValue(const Value&& value)
+    // only used with Options::minEmitInterval, accessed with the lock held
+    TimerService::Clock::time_point m_lastEmit;
+    bool m_trailingEmitPending = false;
+    // only used with Options::offloadEmission
+    std::atomic<bool> m_deliveryPending = false;
+
+    Snapshot setValue(Value&& value)
     {
         std::unique_lock<SpinLock> guard(this->lock);
-        this->m_value = std::move(value);
-        signal(this->m_value);
-        return this->m_value;
+        return this->publishValue(std::move(value));
+    }
+
+    // Must be called with the lock held (or before the attribute is shared)
+    Snapshot publishValue(Value&& value)
+    {
+        if constexpr (Options::suppressUnchanged)
+        {
+            Snapshot current = this->getSnapshot();
+            if (commonAPIValueUnchanged<Options>(*current, value))
+                return current;
+        }
+
+        Snapshot snapshot = std::make_shared<const Value>(std::move(value));
+        std::atomic_store_explicit(&this->m_snapshot, snapshot, std::memory_order_release);
+        this->emit(snapshot);
+        return snapshot;
+    }
+
+    // Must be called with the lock held
+    void emit(const Snapshot& snapshot)
+    {
+        if constexpr (Options::minEmitInterval.count() > 0)
+        {
+            if (m_trailingEmitPending)
+                return; // the trailing signal will carry the latest snapshot
+
+            auto now = TimerService::Clock::now();
+            auto self = this->weak_from_this();
+            // still being constructed, there is nothing to schedule on
+            if (now - m_lastEmit < Options::minEmitInterval && !self.expired())
+            {
+                m_trailingEmitPending = true;
+                TimerService::shared().schedule(m_lastEmit + Options::minEmitInterval, [self]() {
+                    if (auto attribute = self.lock())
+                        attribute->emitTrailing();
+                });
+                return;
+            }
+            m_lastEmit = now;
+        }
+        this->deliver(snapshot);
+    }
+
+    void emitTrailing()
+    {
+        std::lock_guard<SpinLock> guard(this->lock);
+        m_trailingEmitPending = false;
+        m_lastEmit = TimerService::Clock::now();
+        this->deliver(this->getSnapshot());
+    }
+
+    void deliver(const Snapshot& snapshot)
+    {
+        if constexpr (Options::offloadEmission)
+        {
+            if (m_deliveryPending.exchange(true, std::memory_order_acq_rel))
+                return; // the pending delivery will signal the latest snapshot
+
+            auto self = this->weak_from_this();
+            if (!self.expired())
+            {
+                commonAPISingletonNotificationExecutor->post([self]() {
+                    if (auto attribute = self.lock())
+                    {
+                        // cleared before loading, so later snapshots post again
+                        attribute->m_deliveryPending.store(false, std::memory_order_release);
+                        attribute->signal(*attribute->getSnapshot());
+                    }
+                });
+                return;
+            }
+            // still being constructed, signal right away
+            m_deliveryPending.store(false, std::memory_order_release);
+        }
+        signal(*snapshot);
     }
 };
 
 // Always call CommonAPI to get a fresh value, it's never cached
+//
+// getSharedValue() coalesces concurrent fetches, but only joins a fetch that
+// started after the caller arrived, so a value never predates the call. For
+// request-scoped reuse see GraphQLRequestState::getMemoizedValue()
 template <typename TValue, typename TProxy, typename TAttribute,
     TAttribute& (TProxy::Proxy::*TGetAttribute)()>
 class CommonAPIAlwaysGetValueProxyAttribute
@@ -375,6 +685,7 @@ public:
         typename CommonAPIBaseProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>::Attribute;
     using typename CommonAPIBaseProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>::Value;
     typedef CommonAPIAlwaysGetValueProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute> Self;
+    typedef std::shared_ptr<const Value> SharedValue;
 
     static std::shared_ptr<Self> create(SingletonStorage* storage)
     {
@@ -383,7 +694,7 @@ public:
 
     static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::deferred, create, storage);
+        return storage->async(create, storage);
     }
 
     using CommonAPIBaseProxyAttribute<Value, Proxy, Attribute,
@@ -392,6 +703,56 @@ public:
         CommonAPIAlwaysGetValueProxyAttribute const& other) = delete;
     CommonAPIAlwaysGetValueProxyAttribute(CommonAPIAlwaysGetValueProxyAttribute&& other) = delete;
 
+    // Fetches the value, or joins a fetch in flight that started after this call.
+    // A fetch in flight when called may predate a mutation the caller expects to
+    // see, so it's waited and the caller joins (or starts) the next one.
+    SharedValue getSharedValue() const
+    {
+        bool waitedOlderFetch = false;
+        while (true)
+        {
+            std::unique_lock<SpinLock> guard(this->m_inFlightLock);
+            if (this->m_inFlight.valid())
+            {
+                auto future = this->m_inFlight;
+                guard.unlock();
+                if (waitedOlderFetch)
+                    return future.get();
+
+                future.wait();
+                waitedOlderFetch = true;
+                continue;
+            }
+
+            std::promise<SharedValue> promise;
+            std::shared_future<SharedValue> future = promise.get_future().share();
+            this->m_inFlight = future;
+            guard.unlock();
+
+            std::exception_ptr error;
+            SharedValue value;
+            try
+            {
+                value = std::make_shared<const Value>(this->fetchValue());
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            // cleared before completing, so the waiters of this fetch don't join it again
+            guard.lock();
+            this->m_inFlight = std::shared_future<SharedValue>();
+            guard.unlock();
+
+            if (error)
+                promise.set_exception(error);
+            else
+                promise.set_value(std::move(value));
+            return future.get();
+        }
+    }
+
     // No need to lock, but it's a copy, not a reference!
     inline Value getValue() const
     {
@@ -410,10 +771,45 @@ public:
         return TConverted(this->getValue());
     }
 
+    // The futures may be returned by resolvers as service::FieldResult, so
+    // independent fields are fetched in parallel
+    inline std::future<Value> getValueAsync() const
+    {
+        return this->fetchValueAsync();
+    }
+
+    // The remote call is started right away, convert is called when the
+    // returned future is waited
+    template <typename TConverted>
+    inline std::future<TConverted> getValueAsync(
+        std::function<TConverted(Value&&)>&& convert) const
+    {
+        return std::async(std::launch::deferred,
+            [response = this->fetchValueAsync(), convert = std::move(convert)]() mutable {
+                return convert(response.get());
+            });
+    }
+
+    template <typename TConverted>
+    inline std::future<TConverted> getValueAsync() const
+    {
+        return std::async(std::launch::deferred,
+            [response = this->fetchValueAsync()]() mutable { return TConverted(response.get()); });
+    }
+
     inline void mutateValue(const Value& input)
     {
         this->changeValue(input);
     }
+
+    inline std::future<Value> mutateValueAsync(const Value& input)
+    {
+        return this->changeValueAsync(input);
+    }
+
+protected:
+    mutable SpinLock m_inFlightLock = SpinLock(this);
+    mutable std::shared_future<SharedValue> m_inFlight;
 };
 
 // Observe the value using getChangeEvent().subscribe()
@@ -435,7 +831,7 @@ public:
 
     static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::async, create, storage);
+        return storage->async(create, storage);
     }
 
     explicit CommonAPISubscriptionOnlyProxyAttribute(typename Singleton<Proxy>::Ref&& proxySingleton)
@@ -455,42 +851,32 @@ public:
     }
 
 protected:
+    using typename CommonAPICachedProxyAttribute<TValue, TProxy, TAttribute, TGetAttribute>::Options;
+
     std::optional<typename CommonAPI::Event<Value>::Subscription> m_subscription;
-    bool subscriptionAnswered;
 
     void subscribeChanges()
     {
-        subscriptionAnswered = false;
-        std::mutex m;
-        std::condition_variable cv;
-
-        std::thread t([this, &cv, &m]() {
-            std::unique_lock<std::mutex> timerLock(m);
-            if (cv.wait_for(timerLock, std::chrono::seconds(SUBSCRIPTION_TIMEOUT_SECONDS))
-                == std::cv_status::timeout)
-            {
-                DLT_LOG(dltCommonAPI,
-                    DLT_LOG_WARN,
-                    DLT_CSTRING("Subscription timeout! Took too long to send the cached value "),
-                    DLT_PTR(this));
-                dbg(COLOR_BG_MAGENTA "Subscription timeout! Took too long to send the cached value " << this);
-            }
-        });
-
-        this->m_subscription =
-            this->m_attribute.getChangedEvent().subscribe([this, &cv](const Value& value) {
-                if (!this->subscriptionAnswered)
-                {
-                    this->subscriptionAnswered = true;
-                    cv.notify_one();
-                }
-                this->setValue(std::move(value));
+        // shared with the handler, it outlives this call
+        auto answered = std::make_shared<std::promise<void>>();
+        auto notified = std::make_shared<std::atomic<bool>>(false);
+        std::future<void> firstValue = answered->get_future();
+
+        this->m_subscription = this->m_attribute.getChangedEvent().subscribe(
+            [this, answered, notified](const Value& value) {
+                this->setValue(Value(value));
+                if (!notified->exchange(true))
+                    answered->set_value();
             });
 
-        t.join();
-
-        if (!subscriptionAnswered)
+        if (firstValue.wait_for(Options::subscriptionTimeout) == std::future_status::timeout)
         {
+            DLT_LOG(dltCommonAPI,
+                DLT_LOG_WARN,
+                DLT_CSTRING("Subscription timeout! Took too long to send the cached value "),
+                DLT_PTR(this));
+            dbg(COLOR_BG_MAGENTA "Subscription timeout! Took too long to send the cached value " << this);
+
             this->unsubscribeChanges();
             std::ostringstream error_message;
             error_message << "Subscription timeout! "
@@ -537,7 +923,7 @@ public:
 
     static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::async, create, storage);
+        return storage->async(create, storage);
     }
 
     explicit CommonAPISubscriptionProxyAttribute(typename Singleton<Proxy>::Ref&& proxySingleton)
@@ -598,12 +984,27 @@ public:
     }
 
 protected:
+    typedef CommonAPIAttributeOptions<TGetAttribute> Options;
+
     typename Singleton<Proxy>::Ref&& m_proxySingleton;
     Attribute& m_attribute;
     std::optional<typename Attribute::Subscription> m_subscription;
+    std::shared_ptr<MemoryPool> m_eventPool =
+        Options::eventPoolSize > 0 ? std::make_shared<MemoryPool>(Options::eventPoolSize) : nullptr;
+    // signals run without the lock held, in the order events were processed
+    EmissionSequencer m_emission;
 
     virtual void processEvent(typename EventHandler::Tuple&& tuple) = 0;
 
+    template <typename TEvent>
+    inline std::shared_ptr<TEvent> makeEvent(typename EventHandler::Tuple&& tuple)
+    {
+        if constexpr (Options::eventPoolSize > 0)
+            return std::allocate_shared<TEvent>(PoolAllocator<TEvent>(m_eventPool), std::move(tuple));
+        else
+            return std::make_shared<TEvent>(std::move(tuple));
+    }
+
     void subscribeChanges()
     {
         DLT_LOG(dltCommonAPI,
@@ -648,7 +1049,7 @@ public:
     typedef CommonAPIBroadcastSubscriptionProxyAttribute<Event, Proxy, Attribute, TGetAttribute>
         Self;
 
-    boost::signals2::signal<void(const Event&)> signal;
+    ObserverList<void(const Event&)> signal;
 
     static std::shared_ptr<Self> create(SingletonStorage* storage)
     {
@@ -657,7 +1058,7 @@ public:
 
     static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::deferred, create, storage);
+        return storage->async(create, storage);
     }
 
     using CommonAPIEventSubscriptionProxyAttribute<Proxy, Attribute,
@@ -695,12 +1096,18 @@ protected:
 
     void processEvent(typename EventHandler::Tuple&& tuple) override
     {
+        auto event = this->template makeEvent<Event>(std::move(tuple));
         std::unique_lock<SpinLock> guard(this->lock);
-        m_value = std::make_shared<Event>(std::move(tuple));
-        signal(*m_value);
+        m_value = event;
+        auto ticket = this->m_emission.ticket();
+        guard.unlock();
+        this->m_emission.emit(ticket, [this, &event]() { signal(*event); });
     }
 };
 
+// Keeps the latest event of each kind, see UniqueEventStore. If
+// Options::accumulativeCapacity is set, the least recently updated events are
+// evicted when it's exceeded.
 template <typename TEvent, typename TProxy, typename TAttribute,
     TAttribute& (TProxy::Proxy::*TGetAttribute)()>
 class CommonAPIAccumulativeUniqueEventSubscriptionProxyAttribute
@@ -715,12 +1122,13 @@ public:
         TGetAttribute>::EventHandler;
 
     typedef TEvent Event;
-    typedef std::vector<std::shared_ptr<Event>> Value;
+    typedef typename UniqueEventStore<Event>::Value Value;
+    typedef typename UniqueEventStore<Event>::Snapshot Snapshot;
     typedef CommonAPIAccumulativeUniqueEventSubscriptionProxyAttribute<Event, Proxy, Attribute,
         TGetAttribute>
         Self;
 
-    boost::signals2::signal<void(const Value&)> signal;
+    ObserverList<void(const Value&)> signal;
 
     static std::shared_ptr<Self> create(SingletonStorage* storage)
     {
@@ -729,7 +1137,7 @@ public:
 
     static std::future<std::shared_ptr<Self>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::deferred, create, storage);
+        return storage->async(create, storage);
     }
 
     using CommonAPIEventSubscriptionProxyAttribute<Proxy, Attribute,
@@ -739,44 +1147,47 @@ public:
     CommonAPIAccumulativeUniqueEventSubscriptionProxyAttribute(
         CommonAPIAccumulativeUniqueEventSubscriptionProxyAttribute&& other) = delete;
 
-    inline LockedValueReference<const Value, SpinLock> getValue()
+    // Only waits for the store lock if events changed since the last read, the
+    // returned snapshot is immutable
+    inline Snapshot getSnapshot() const
     {
-        return LockedValueReference<const Value, SpinLock>(this->m_value, this->lock);
+        return this->m_events.snapshot();
+    }
+
+    inline SnapshotValueReference<const Value> getValue() const
+    {
+        return SnapshotValueReference<const Value>(this->getSnapshot());
     }
 
     template <typename TConverted>
-    inline TConverted getValue(std::function<TConverted(const Value&)>&& convert)
+    inline TConverted getValue(std::function<TConverted(const Value&)>&& convert) const
     {
-        std::lock_guard<SpinLock> guard(this->lock);
-        return convert(this->m_value);
+        return convert(*this->getSnapshot());
     }
 
     template <typename TConverted>
-    inline TConverted getValue()
+    inline TConverted getValue() const
     {
-        std::lock_guard<SpinLock> guard(this->lock);
-        return TConverted(const_cast<const Value&>(this->m_value));
+        return TConverted(*this->getSnapshot());
     }
 
 protected:
-    Value m_value;
+    using typename CommonAPIEventSubscriptionProxyAttribute<Proxy, Attribute, TGetAttribute>::Options;
+
+    UniqueEventStore<Event> m_events { Options::accumulativeCapacity };
 
     void processEvent(typename EventHandler::Tuple&& tuple) override
     {
+        auto event = this->template makeEvent<Event>(std::move(tuple));
         std::unique_lock<SpinLock> guard(this->lock);
-        auto event = std::make_shared<Event>(std::move(tuple));
-        auto it = std::find_if(m_value.begin(), m_value.end(), [event](const auto& other) -> bool {
-            return Event::findPredicate(*event, *other);
+        m_events.upsert(std::move(event));
+        auto ticket = this->m_emission.ticket();
+        guard.unlock();
+        // the snapshot is only built when observed, once per burst of events
+        this->m_emission.emit(ticket, [this]() {
+            if (!signal.empty())
+                signal(*this->getSnapshot());
         });
-        if (it == m_value.end())
-        {
-            m_value.push_back(std::move(event));
-        }
-        else
-        {
-            *it = std::move(event);
-        }
-        signal(m_value);
     }
 };
 
@@ -815,6 +1226,16 @@ protected:
         COMMONAPI_PROXY_ATTRIBUTE_TEMPLATE_ARGS(_proxy, get##_name)>                               \
         _proxy##__##_name
 
+// Specialize the options of an attribute, must be used before the attribute
+// singleton is instantiated. Ex:
+//   COMMONAPI_ATTRIBUTE_OPTIONS(MyProxy, SpeedAttribute) : public CommonAPIDefaultAttributeOptions
+//   {
+//       static constexpr std::chrono::milliseconds subscriptionTimeout = std::chrono::seconds(1);
+//   };
+#define COMMONAPI_ATTRIBUTE_OPTIONS(_proxy, _name)                                                \
+    template <>                                                                                    \
+    struct CommonAPIAttributeOptions<&_proxy::Proxy::get##_name>
+
 #define TYPEDEF_COMMONAPI_PROXY(_proxy, _instanceId, _name)                                        \
     static constexpr std::string_view _name##__instanceId(_instanceId);                            \
     typedef CommonAPIProxy<_proxy, _name##__instanceId> _name
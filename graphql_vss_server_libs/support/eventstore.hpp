@@ -0,0 +1,156 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "spinlock.hpp"
+
+// Events providing a `key()` method (the result must be hashable) are indexed
+// by it, otherwise Event::findPredicate() is used to find the existing event.
+template <typename TEvent, typename = void>
+struct EventKeyTraits
+{
+    static constexpr bool hasKey = false;
+    typedef int Key; // unused
+};
+
+template <typename TEvent>
+struct EventKeyTraits<TEvent, std::void_t<decltype(std::declval<const TEvent&>().key())>>
+{
+    static constexpr bool hasKey = true;
+    typedef std::decay_t<decltype(std::declval<const TEvent&>().key())> Key;
+};
+
+// Keeps the latest event of each kind (by key or findPredicate).
+//
+// Without a capacity, events are kept in the order they first arrived. With a
+// capacity, an updated event moves to the back and the least recently updated
+// events are evicted first, so a frequently updated event is never evicted in
+// favor of stale ones.
+//
+// Readers get an immutable snapshot, rebuilt on the first read after a change:
+// bursts of upserts cost O(1) each (keyed events) and a single O(n) rebuild.
+template <typename TEvent>
+class UniqueEventStore
+{
+public:
+    typedef TEvent Event;
+    typedef std::vector<std::shared_ptr<Event>> Value;
+    typedef std::shared_ptr<const Value> Snapshot;
+    typedef EventKeyTraits<Event> KeyTraits;
+
+    // 0 is unlimited
+    explicit UniqueEventStore(size_t capacity = 0)
+        : m_capacity(capacity)
+    {
+    }
+
+    UniqueEventStore(UniqueEventStore const& other) = delete;
+    UniqueEventStore(UniqueEventStore&& other) = delete;
+
+    void upsert(std::shared_ptr<Event>&& event)
+    {
+        std::lock_guard<SpinLock> guard(m_lock);
+
+        auto it = find(*event);
+        if (it == m_events.end())
+        {
+            m_events.push_back(std::move(event));
+            if constexpr (KeyTraits::hasKey)
+                m_index.emplace(m_events.back()->key(), std::prev(m_events.end()));
+            evictOldest();
+        }
+        else
+        {
+            // splice() keeps the iterators in m_index valid
+            if (m_capacity > 0)
+                m_events.splice(m_events.end(), m_events, it);
+            *it = std::move(event);
+        }
+
+        m_dirty.store(true, std::memory_order_release);
+    }
+
+    // Only takes m_lock if the events changed since the last snapshot, otherwise
+    // it's just an atomic load of the shared_ptr (not lock-free in libstdc++,
+    // but it never waits for a writer holding m_lock)
+    Snapshot snapshot() const
+    {
+        if (!m_dirty.load(std::memory_order_acquire))
+            return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+
+        std::lock_guard<SpinLock> guard(m_lock);
+        if (m_dirty.load(std::memory_order_relaxed))
+        {
+            std::atomic_store_explicit(&m_snapshot,
+                std::make_shared<const Value>(m_events.begin(), m_events.end()),
+                std::memory_order_release);
+            m_dirty.store(false, std::memory_order_relaxed);
+        }
+        return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<SpinLock> guard(m_lock);
+        return m_events.size();
+    }
+
+private:
+    typedef std::list<std::shared_ptr<Event>> Events;
+
+    const size_t m_capacity;
+
+    // m_events and m_index are only accessed with the lock held
+    mutable SpinLock m_lock = SpinLock(this);
+    Events m_events;
+    std::unordered_map<typename KeyTraits::Key, typename Events::iterator> m_index;
+
+    mutable std::atomic<bool> m_dirty = false;
+    mutable Snapshot m_snapshot = std::make_shared<const Value>();
+
+    typename Events::iterator find(const Event& event)
+    {
+        if constexpr (KeyTraits::hasKey)
+        {
+            auto itr = m_index.find(event.key());
+            return itr != m_index.end() ? itr->second : m_events.end();
+        }
+        else
+        {
+            return std::find_if(m_events.begin(), m_events.end(), [&event](const auto& other) {
+                return Event::findPredicate(event, *other);
+            });
+        }
+    }
+
+    void evictOldest()
+    {
+        while (m_capacity > 0 && m_events.size() > m_capacity)
+        {
+            if constexpr (KeyTraits::hasKey)
+                m_index.erase(m_events.front()->key());
+            m_events.pop_front();
+        }
+    }
+};
@@ -0,0 +1,109 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+
+#include "debug.hpp"
+
+#include "executor.hpp"
+
+ThreadPoolExecutor::ThreadPoolExecutor(size_t maxThreads)
+    : m_maxThreads(std::max<size_t>(maxThreads, 1))
+{
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    std::unique_lock lock(m_lock);
+    m_stopping = true;
+    lock.unlock();
+    m_hasWork.notify_all();
+
+    // pending tasks are still executed before the threads exit
+    for (auto& t : m_threads)
+        t.join();
+}
+
+size_t ThreadPoolExecutor::defaultThreadCount()
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 2);
+}
+
+void ThreadPoolExecutor::post(Task&& task)
+{
+    std::unique_lock lock(m_lock);
+    m_queue.push_back(std::move(task));
+    m_metrics.queueDepth = m_queue.size();
+    m_metrics.maxQueueDepth = std::max(m_metrics.maxQueueDepth, m_metrics.queueDepth);
+
+    if (m_idleThreads == 0 && m_threads.size() < m_maxThreads)
+    {
+        dbg("ThreadPoolExecutor " << this << " start thread #" << m_threads.size());
+        m_threads.emplace_back(&ThreadPoolExecutor::run, this);
+        return;
+    }
+
+    lock.unlock();
+    m_hasWork.notify_one();
+}
+
+void ThreadPoolExecutor::join()
+{
+    std::unique_lock lock(m_lock);
+    m_isIdle.wait(lock, [this] { return m_queue.empty() && m_metrics.activeTasks == 0; });
+}
+
+ExecutorMetrics ThreadPoolExecutor::metrics() const
+{
+    std::lock_guard guard(m_lock);
+    return m_metrics;
+}
+
+void ThreadPoolExecutor::run()
+{
+    std::unique_lock lock(m_lock);
+    while (true)
+    {
+        m_idleThreads++;
+        m_hasWork.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        m_idleThreads--;
+
+        if (m_queue.empty())
+            return; // stopping
+
+        Task task = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_metrics.queueDepth = m_queue.size();
+        m_metrics.activeTasks++;
+        lock.unlock();
+
+        try
+        {
+            task();
+        }
+        catch (const std::exception& ex)
+        {
+            dbg(COLOR_RED "ThreadPoolExecutor " << this << " task failed: " << ex.what());
+        }
+        catch (...)
+        {
+            dbg(COLOR_RED "ThreadPoolExecutor " << this << " task failed");
+        }
+        task = nullptr; // release captures outside of the lock
+
+        lock.lock();
+        m_metrics.activeTasks--;
+        m_metrics.completedTasks++;
+        if (m_queue.empty() && m_metrics.activeTasks == 0)
+            m_isIdle.notify_all();
+    }
+}
@@ -0,0 +1,167 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "graphql_vss_server_libs-support_export.h"
+
+struct ExecutorMetrics
+{
+    size_t queueDepth = 0;    // tasks waiting for a thread
+    size_t maxQueueDepth = 0; // high watermark of queueDepth
+    size_t activeTasks = 0;   // tasks being executed right now
+    uint64_t completedTasks = 0;
+};
+
+// Runs tasks in other threads. Implement this to plug your own executor
+// in SingletonStorage::setExecutor()
+class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT Executor
+{
+public:
+    typedef std::function<void(void)> Task;
+
+    virtual ~Executor() = default;
+
+    virtual void post(Task&& task) = 0;
+
+    // Wait all posted tasks to finish, must not be called from a task!
+    virtual void join() = 0;
+
+    virtual ExecutorMetrics metrics() const
+    {
+        return ExecutorMetrics();
+    }
+};
+
+// Bounded thread pool, threads are started on demand up to maxThreads.
+// Tasks posted while all threads are busy are queued.
+class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ThreadPoolExecutor : public Executor
+{
+public:
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT explicit ThreadPoolExecutor(
+        size_t maxThreads = defaultThreadCount());
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ~ThreadPoolExecutor() override;
+
+    ThreadPoolExecutor(ThreadPoolExecutor const&) = delete;
+    ThreadPoolExecutor(ThreadPoolExecutor&&) = delete;
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void post(Task&& task) override;
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void join() override;
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ExecutorMetrics metrics() const override;
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT static size_t defaultThreadCount();
+
+private:
+    const size_t m_maxThreads;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_hasWork;
+    std::condition_variable m_isIdle;
+    std::deque<Task> m_queue;
+    std::vector<std::thread> m_threads;
+    size_t m_idleThreads = 0;
+    bool m_stopping = false;
+    ExecutorMetrics m_metrics;
+
+    void run();
+};
+
+// Posts fn to the executor, but if nobody started it by the time the returned
+// future is waited, the waiter runs it instead. This avoids dead locks when all
+// executor threads are waiting for tasks that are still queued.
+//
+// The result is moved to the returned future, the executor never keeps it alive.
+template <typename Fn>
+auto postStealable(Executor& executor, Fn&& fn) -> std::future<std::invoke_result_t<Fn>>
+{
+    typedef std::invoke_result_t<Fn> Result;
+    typedef std::conditional_t<std::is_void_v<Result>, bool, Result> Storage;
+
+    struct StealableTask
+    {
+        std::decay_t<Fn> fn;
+        std::atomic<bool> claimed { false };
+
+        std::mutex lock;
+        std::condition_variable done;
+        std::optional<Storage> value;
+        std::exception_ptr error;
+
+        explicit StealableTask(Fn&& _fn)
+            : fn(std::forward<Fn>(_fn))
+        {
+        }
+
+        void run()
+        {
+            if (claimed.exchange(true))
+                return;
+
+            std::optional<Storage> result;
+            std::exception_ptr exception;
+            try
+            {
+                if constexpr (std::is_void_v<Result>)
+                {
+                    fn();
+                    result.emplace(true);
+                }
+                else
+                    result.emplace(fn());
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            std::lock_guard guard(lock);
+            value = std::move(result);
+            error = exception;
+            done.notify_all();
+        }
+
+        Result take()
+        {
+            std::unique_lock guard(lock);
+            done.wait(guard, [this] { return value.has_value() || error; });
+            if (error)
+                std::rethrow_exception(error);
+            if constexpr (!std::is_void_v<Result>)
+                return std::move(*value);
+        }
+    };
+
+    auto task = std::make_shared<StealableTask>(std::forward<Fn>(fn));
+    // weak: once it's stolen or the future is gone, there is no reason to run it
+    executor.post([weakTask = std::weak_ptr<StealableTask>(task)] {
+        if (auto task = weakTask.lock())
+            task->run();
+    });
+    // deferred functions run exactly once, so take() is called once
+    return std::async(std::launch::deferred, [task]() -> Result {
+        task->run();
+        return task->take();
+    });
+}
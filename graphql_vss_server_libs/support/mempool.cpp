@@ -0,0 +1,85 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include <mutex>
+
+#include "debug.hpp"
+
+#include "mempool.hpp"
+
+MemoryPool::MemoryPool(size_t maxFreeBlocks)
+    : m_maxFreeBlocks(maxFreeBlocks)
+{
+}
+
+MemoryPool::~MemoryPool()
+{
+    dbg("~MemoryPool " << this << " allocations=" << m_stats.allocations
+                       << " recycled=" << m_stats.recycled);
+    for (auto& head : m_freeLists)
+    {
+        while (head)
+        {
+            auto block = head;
+            head = block->next;
+            ::operator delete(block);
+        }
+    }
+}
+
+void* MemoryPool::allocate(size_t size)
+{
+    if (size == 0 || size > maxBlockSize)
+        return ::operator new(size);
+
+    auto index = sizeClass(size);
+    {
+        std::lock_guard<SpinLock> guard(m_lock);
+        m_stats.allocations++;
+        if (auto block = m_freeLists[index])
+        {
+            m_freeLists[index] = block->next;
+            m_stats.freeBlocks--;
+            m_stats.recycled++;
+            return block;
+        }
+    }
+
+    // whole size class, so the block can be reused by any size in it
+    return ::operator new((index + 1) * blockGranularity);
+}
+
+void MemoryPool::deallocate(void* ptr, size_t size) noexcept
+{
+    if (size != 0 && size <= maxBlockSize)
+    {
+        std::lock_guard<SpinLock> guard(m_lock);
+        if (m_stats.freeBlocks < m_maxFreeBlocks)
+        {
+            auto index = sizeClass(size);
+            auto block = static_cast<FreeBlock*>(ptr);
+            block->next = m_freeLists[index];
+            m_freeLists[index] = block;
+            m_stats.freeBlocks++;
+            return;
+        }
+    }
+
+    ::operator delete(ptr);
+}
+
+MemoryPoolStats MemoryPool::stats() const
+{
+    std::lock_guard<SpinLock> guard(m_lock);
+    return m_stats;
+}
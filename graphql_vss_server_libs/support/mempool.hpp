@@ -0,0 +1,126 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "spinlock.hpp"
+
+#include "graphql_vss_server_libs-support_export.h"
+
+struct MemoryPoolStats
+{
+    uint64_t allocations = 0; // blocks requested from the pool
+    uint64_t recycled = 0;    // allocations served from a released block
+    size_t freeBlocks = 0;    // released blocks kept for reuse
+};
+
+// Keeps released small blocks (up to maxBlockSize bytes) in per-size free lists
+// so they can be reused without going to the global allocator. At most
+// maxFreeBlocks are kept, extra blocks are returned to the global allocator.
+//
+// Use it with PoolAllocator and std::allocate_shared(), the control block
+// keeps the pool alive until the last object is released.
+class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT MemoryPool
+{
+public:
+    static constexpr size_t blockGranularity = alignof(std::max_align_t);
+    static constexpr size_t maxBlockSize = 512;
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT explicit MemoryPool(size_t maxFreeBlocks);
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ~MemoryPool();
+
+    MemoryPool(MemoryPool const&) = delete;
+    MemoryPool(MemoryPool&&) = delete;
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void* allocate(size_t size);
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void deallocate(void* ptr, size_t size) noexcept;
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT MemoryPoolStats stats() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static constexpr size_t sizeClasses = maxBlockSize / blockGranularity;
+
+    const size_t m_maxFreeBlocks;
+    mutable SpinLock m_lock = SpinLock(this);
+    std::array<FreeBlock*, sizeClasses> m_freeLists {};
+    MemoryPoolStats m_stats;
+
+    static inline size_t sizeClass(size_t size)
+    {
+        return (size + blockGranularity - 1) / blockGranularity - 1;
+    }
+};
+
+// std::allocator compatible allocator backed by a shared MemoryPool
+template <typename T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+
+    explicit PoolAllocator(std::shared_ptr<MemoryPool> pool) noexcept
+        : m_pool(std::move(pool))
+    {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : m_pool(other.m_pool)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if constexpr (alignof(T) > MemoryPool::blockGranularity)
+            return std::allocator<T>().allocate(n);
+        else
+            return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        if constexpr (alignof(T) > MemoryPool::blockGranularity)
+            std::allocator<T>().deallocate(ptr, n);
+        else
+            m_pool->deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept
+    {
+        return m_pool == other.m_pool;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept
+    {
+        return m_pool != other.m_pool;
+    }
+
+private:
+    template <typename U>
+    friend class PoolAllocator;
+
+    std::shared_ptr<MemoryPool> m_pool;
+};
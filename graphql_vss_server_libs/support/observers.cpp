@@ -0,0 +1,56 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include "observers.hpp"
+
+ObserverConnection::ObserverConnection(
+    std::shared_ptr<ObserverSlot> slot, std::weak_ptr<ObserverListState> list) noexcept
+    : m_slot(std::move(slot))
+    , m_list(std::move(list))
+{
+}
+
+ObserverConnection::~ObserverConnection()
+{
+    disconnect();
+}
+
+ObserverConnection& ObserverConnection::operator=(ObserverConnection&& other) noexcept
+{
+    if (this != &other)
+    {
+        disconnect();
+        m_slot = std::move(other.m_slot);
+        m_list = std::move(other.m_list);
+    }
+    return *this;
+}
+
+void ObserverConnection::disconnect() noexcept
+{
+    if (!m_slot)
+        return;
+
+    auto slot = std::move(m_slot);
+    if (!slot->connected.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    if (auto list = m_list.lock())
+        list->slotDisconnected();
+    m_list.reset();
+}
+
+bool ObserverConnection::connected() const noexcept
+{
+    return m_slot && m_slot->connected.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,238 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "spinlock.hpp"
+
+#include "graphql_vss_server_libs-support_export.h"
+
+struct ObserverSlot
+{
+    std::atomic<bool> connected { true };
+};
+
+struct ObserverListState
+{
+    virtual ~ObserverListState() = default;
+    virtual void slotDisconnected() noexcept = 0;
+};
+
+// Disconnects the observer when destroyed (like boost::signals2::scoped_connection).
+// It may outlive the ObserverList.
+class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ObserverConnection
+{
+public:
+    ObserverConnection() = default;
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ObserverConnection(
+        std::shared_ptr<ObserverSlot> slot, std::weak_ptr<ObserverListState> list) noexcept;
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ~ObserverConnection();
+
+    ObserverConnection(ObserverConnection const&) = delete;
+    ObserverConnection& operator=(ObserverConnection const&) = delete;
+    ObserverConnection(ObserverConnection&& other) noexcept = default;
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ObserverConnection& operator=(
+        ObserverConnection&& other) noexcept;
+
+    // O(1), the observer won't be called by emissions started after this
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void disconnect() noexcept;
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT bool connected() const noexcept;
+
+private:
+    std::shared_ptr<ObserverSlot> m_slot;
+    std::weak_ptr<ObserverListState> m_list;
+};
+
+template <typename Signature>
+class ObserverList;
+
+// Replaces boost::signals2::signal for attribute singletons.
+//
+// Emission doesn't allocate nor wait for connect()/disconnect(): it walks an
+// immutable snapshot of the observers, loaded with std::atomic_load() (which
+// isn't lock-free in libstdc++, it briefly takes a mutex from a global pool).
+// connect() copies the snapshot (copy-on-write) while disconnect() only flags
+// the slot, disconnected slots are dropped in batches.
+template <typename... Args>
+class ObserverList<void(Args...)>
+{
+public:
+    typedef std::function<void(Args...)> Observer;
+
+    ObserverList() = default;
+    ObserverList(ObserverList const&) = delete;
+    ObserverList(ObserverList&&) = delete;
+
+    ~ObserverList()
+    {
+        std::lock_guard<SpinLock> guard(m_state->lock);
+        for (const auto& slot : *m_state->slots)
+            slot->connected.store(false, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] ObserverConnection connect(Observer&& observer)
+    {
+        auto slot = std::make_shared<Slot>(std::move(observer));
+
+        std::lock_guard<SpinLock> guard(m_state->lock);
+        auto slots = std::make_shared<Slots>();
+        slots->reserve(m_state->slots->size() + 1);
+        for (const auto& other : *m_state->slots)
+        {
+            if (other->connected.load(std::memory_order_relaxed))
+                slots->push_back(other);
+        }
+        slots->push_back(slot);
+        m_state->publish(std::move(slots));
+
+        return ObserverConnection(slot, m_state);
+    }
+
+    void operator()(Args... args) const
+    {
+        auto slots = std::atomic_load_explicit(&m_state->slots, std::memory_order_acquire);
+        for (const auto& slot : *slots)
+        {
+            if (slot->connected.load(std::memory_order_acquire))
+                slot->observer(args...);
+        }
+    }
+
+    size_t size() const
+    {
+        size_t count = 0;
+        auto slots = std::atomic_load_explicit(&m_state->slots, std::memory_order_acquire);
+        for (const auto& slot : *slots)
+        {
+            if (slot->connected.load(std::memory_order_relaxed))
+                count++;
+        }
+        return count;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    struct Slot : public ObserverSlot
+    {
+        Observer observer;
+
+        explicit Slot(Observer&& _observer)
+            : observer(std::move(_observer))
+        {
+        }
+    };
+
+    typedef std::vector<std::shared_ptr<Slot>> Slots;
+
+    struct State : public ObserverListState
+    {
+        // serializes writers, emission doesn't lock
+        SpinLock lock = SpinLock(this);
+        std::shared_ptr<const Slots> slots = std::make_shared<const Slots>();
+        size_t disconnected = 0;
+
+        void publish(std::shared_ptr<const Slots>&& newSlots)
+        {
+            std::atomic_store_explicit(&slots, std::move(newSlots), std::memory_order_release);
+            disconnected = 0;
+        }
+
+        void slotDisconnected() noexcept override
+        {
+            std::lock_guard<SpinLock> guard(lock);
+            // drop them once they are the majority, keeps disconnect amortized O(1)
+            if (++disconnected * 2 <= slots->size())
+                return;
+
+            try
+            {
+                auto newSlots = std::make_shared<Slots>();
+                for (const auto& slot : *slots)
+                {
+                    if (slot->connected.load(std::memory_order_relaxed))
+                        newSlots->push_back(slot);
+                }
+                publish(std::move(newSlots));
+            }
+            catch (...)
+            {
+                // keep the disconnected slots, they are skipped anyway
+            }
+        }
+    };
+
+    std::shared_ptr<State> m_state = std::make_shared<State>();
+};
+
+// Emits in the order values were produced without holding the producer's lock while
+// observers run: take a ticket() with the producer lock held, release it, then emit().
+// Emissions wait for the previous tickets to be done, so observers must not produce
+// values for the same sequencer (it would wait for itself, like a non recursive lock).
+// Each emission takes a mutex twice and notifies a condition variable, see
+// bench_observers for its cost.
+class EmissionSequencer
+{
+public:
+    // must be called with the producer lock held
+    uint64_t ticket() noexcept
+    {
+        return m_next++;
+    }
+
+    template <typename Fn>
+    void emit(uint64_t ticket, Fn&& fn)
+    {
+        std::unique_lock<std::mutex> guard(m_mutex);
+        m_turn.wait(guard, [this, ticket] { return m_current == ticket; });
+        guard.unlock();
+
+        try
+        {
+            fn();
+        }
+        catch (...)
+        {
+            done();
+            throw;
+        }
+        done();
+    }
+
+private:
+    uint64_t m_next = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_turn;
+    uint64_t m_current = 0;
+
+    void done()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_current++;
+        }
+        m_turn.notify_all();
+    }
+};
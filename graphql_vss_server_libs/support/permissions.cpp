@@ -20,5 +20,8 @@ const char* PermissionException::what() const noexcept
 
 void ClientPermissions::insert(const ClientPermissions::Key& permission)
 {
-    m_lookup.insert(permission);
+    if (PermissionMask::isDense(permission))
+        m_dense.set(permission);
+    else
+        m_sparse.insert(permission);
 }
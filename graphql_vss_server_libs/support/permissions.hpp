@@ -12,8 +12,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <set>
+#include <utility>
 
 #include "graphql_vss_server_libs-support_export.h"
 
@@ -22,10 +25,81 @@ struct GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT PermissionException : public std::
     const char* what() const noexcept override;
 };
 
-class ClientPermissions
+// Fixed size bitset of the dense permissions (Key < CAPACITY). Unlike std::bitset it's usable in
+// constant expressions, so masks of constant permissions can be built at compile time.
+class PermissionMask
 {
 public:
     using Key = uint16_t;
+    using Word = uint64_t;
+
+    static constexpr size_t CAPACITY = 1024;
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t WORDS = CAPACITY / WORD_BITS;
+
+    constexpr PermissionMask() = default;
+
+    template <typename... T>
+    constexpr explicit PermissionMask(const Key& permission, const T&... rest)
+    {
+        set(permission);
+        (set(rest), ...);
+    }
+
+    // mask of the dense permissions, others are ignored
+    template <typename... T>
+    static constexpr PermissionMask ofDense(const T&... permissions)
+    {
+        PermissionMask mask;
+        ((isDense(permissions) ? mask.set(permissions) : void()), ...);
+        return mask;
+    }
+
+    static constexpr bool isDense(const Key& permission) noexcept
+    {
+        return permission < CAPACITY;
+    }
+
+    // permission must be dense, otherwise it's not a constant expression
+    constexpr void set(const Key& permission)
+    {
+        if (!isDense(permission))
+            throw PermissionException();
+        m_words[permission / WORD_BITS] |= bit(permission);
+    }
+
+    constexpr bool test(const Key& permission) const noexcept
+    {
+        return isDense(permission) && (m_words[permission / WORD_BITS] & bit(permission)) != 0;
+    }
+
+    constexpr Word word(size_t index) const noexcept
+    {
+        return m_words[index];
+    }
+
+    // all permissions of this mask are in other
+    constexpr bool isSubsetOf(const PermissionMask& other) const noexcept
+    {
+        Word missing = 0;
+        for (size_t i = 0; i < WORDS; i++)
+            missing |= m_words[i] & ~other.m_words[i];
+        return missing == 0;
+    }
+
+private:
+    std::array<Word, WORDS> m_words {};
+
+    static constexpr Word bit(const Key& permission) noexcept
+    {
+        return Word(1) << (permission % WORD_BITS);
+    }
+};
+
+class ClientPermissions
+{
+public:
+    using Key = PermissionMask::Key;
 
     GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void insert(const Key& permission);
 
@@ -35,24 +109,94 @@ public:
 
     inline bool contains(const Key& permission) const noexcept
     {
-        return m_lookup.find(permission) != m_lookup.cend();
+        if (PermissionMask::isDense(permission))
+            return m_dense.test(permission);
+        return m_sparse.find(permission) != m_sparse.cend();
+    }
+
+    template <typename... T>
+    inline bool containsAll(const Key& permission, const T&... rest) const noexcept
+    {
+        return contains(permission) && (contains(rest) && ...);
     }
 
     template <typename... T>
     inline void validate(const Key& permission, const T&... rest) const
     {
-        if (!contains(permission))
+        if (!containsAll(permission, rest...))
         {
             throw PermissionException();
         }
-        if constexpr (sizeof...(rest) > 0)
+    }
+
+    inline bool containsAll(const PermissionMask& required) const noexcept
+    {
+        return required.isSubsetOf(m_dense);
+    }
+
+    // Precomputed masks (ie: static const PermissionMask) are checked with a single AND per word
+    inline void validate(const PermissionMask& required) const
+    {
+        if (!containsAll(required))
+        {
+            throw PermissionException();
+        }
+    }
+
+    // Permissions known at compile time (ie: generated resolvers): only the words with required
+    // bits are checked, usually a single AND and compare
+    template <Key... permissions>
+    inline bool containsAll() const noexcept
+    {
+        return containsAllWords<StaticMask<permissions...>>(
+                   std::make_index_sequence<PermissionMask::WORDS>())
+            && (containsSparse<permissions>() && ...);
+    }
+
+    template <Key... permissions>
+    inline void validate() const
+    {
+        static_assert(sizeof...(permissions) > 0, "at least one permission is required");
+        if (!containsAll<permissions...>())
         {
-            validate(rest...);
+            throw PermissionException();
         }
     }
 
 private:
+    template <Key... permissions>
+    struct StaticMask
+    {
+        static constexpr PermissionMask value = PermissionMask::ofDense(permissions...);
+    };
+
+    template <typename TMask, size_t... index>
+    inline bool containsAllWords(std::index_sequence<index...>) const noexcept
+    {
+        return (containsWord<TMask::value.word(index), index>() && ...);
+    }
+
+    template <PermissionMask::Word required, size_t index>
+    inline bool containsWord() const noexcept
+    {
+        if constexpr (required == 0)
+            return true;
+        else
+            return (m_dense.word(index) & required) == required;
+    }
+
+    template <Key permission>
+    inline bool containsSparse() const noexcept
+    {
+        if constexpr (PermissionMask::isDense(permission))
+            return true;
+        else
+            return m_sparse.find(permission) != m_sparse.cend();
+    }
+
     // How the Request stores the client permissions,
     // must have an efficient lookup!
-    std::set<Key> m_lookup;
+    PermissionMask m_dense;
+    // fallback for the permissions that don't fit the mask
+    std::set<Key> m_sparse;
 };
@@ -12,34 +12,134 @@
 // http://mozilla.org/MPL/2.0/.
 
 #include <boost/lexical_cast.hpp>
+#include <boost/numeric/conversion/converter_policies.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 
 #define SCALARS_HPP_LOCAL_TEMPLATES 1
 #include "scalars.hpp"
 
+// Same checks as boost::numeric_cast (floating point values are truncated), but without
+// exceptions or branches so it can be used in vectorized loops
+template <typename TResult, typename TInput>
+static inline bool isRepresentable(TInput value) noexcept
+{
+    if constexpr (std::is_integral_v<TResult> && std::is_integral_v<TInput>)
+    {
+        constexpr auto max = static_cast<uint64_t>(std::numeric_limits<TResult>::max());
+        if constexpr (std::is_unsigned_v<TInput>)
+            return static_cast<uint64_t>(value) <= max;
+        else if constexpr (std::is_unsigned_v<TResult>)
+            return (value >= 0) & (static_cast<uint64_t>(value) <= max);
+        else
+            return (value >= std::numeric_limits<TResult>::lowest())
+                & (value <= std::numeric_limits<TResult>::max());
+    }
+    else if constexpr (std::is_integral_v<TResult>)
+    {
+        // truncated values fit when lowest - 1 < value < max + 1. max + 1 and lowest are powers
+        // of 2, exactly representable, lowest - 1 may round to lowest. NaN fails all comparisons
+        constexpr TInput upper =
+            static_cast<TInput>(std::numeric_limits<TResult>::max() / 2 + 1) * 2;
+        constexpr TInput lower = static_cast<TInput>(std::numeric_limits<TResult>::lowest());
+        if constexpr (lower - 1 != lower)
+            return (value > lower - 1) & (value < upper);
+        else
+            return (value >= lower) & (value < upper);
+    }
+    else if constexpr (std::is_floating_point_v<TInput> && sizeof(TInput) > sizeof(TResult))
+    {
+        // infinities and NaN are representable
+        const TInput magnitude = std::fabs(value);
+        return !(magnitude > std::numeric_limits<TResult>::max())
+            | (magnitude == std::numeric_limits<TInput>::infinity());
+    }
+    else
+    {
+        return true;
+    }
+}
+
+template <typename TResult, typename TInput>
+static inline TResult numericCast(TInput value)
+{
+    if (isRepresentable<TResult>(value))
+        return static_cast<TResult>(value);
+
+    if constexpr (std::is_floating_point_v<TInput>)
+    {
+        if (std::isnan(value))
+            throw boost::numeric::bad_numeric_cast();
+    }
+    if constexpr (std::is_signed_v<TInput>)
+    {
+        if (value < 0)
+            throw boost::numeric::negative_overflow();
+    }
+    throw boost::numeric::positive_overflow();
+}
+
+template <typename T>
+static inline bool parseNumber(const char* first, const char* last, T& value) noexcept
+{
+    const auto [ptr, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && ptr == last;
+}
+
+static inline double parseFloating(const char* first, const char* last)
+{
+#if defined(__cpp_lib_to_chars)
+    double value;
+    if (!parseNumber(first, last, value))
+        throw boost::bad_lexical_cast();
+    return value;
+#else
+    // std::from_chars() for floating point types is not available (GCC < 11)
+    return boost::lexical_cast<double>(first, static_cast<std::size_t>(last - first));
+#endif
+}
+
+// Strings with a '.' are floating point numbers, others are integers. Parsed as
+// int64_t/uint64_t/double (boost::bad_lexical_cast if not possible) then converted to T
+// (boost::numeric::bad_numeric_cast if out of range)
 template <typename T, std::enable_if_t<std::is_arithmetic<T>::value>*>
 T stringToNumber(const std::string& str)
 {
-    bool isNegative = str.at(0) == '-';
-    bool isFloating = str.find('.') != std::string::npos;
+    if (str.empty())
+        throw std::out_of_range("Empty string is not a number");
 
-    if (isFloating)
+    const char* first = str.data();
+    const char* last = first + str.size();
+    if (first != last && *first == '+' && last - first > 1 && first[1] != '-')
+        ++first; // from_chars() doesn't accept it
+
+    if (first != last && *first == '-')
     {
-        return boost::numeric_cast<T>(boost::lexical_cast<double>(str));
+        int64_t value;
+        if (parseNumber(first, last, value))
+            return numericCast<T>(value);
     }
-
-    if (isNegative)
+    else
     {
-        return boost::numeric_cast<T>(boost::lexical_cast<int64_t>(str));
+        uint64_t value;
+        if (parseNumber(first, last, value))
+            return numericCast<T>(value);
     }
 
-    return boost::numeric_cast<T>(boost::lexical_cast<uint64_t>(str));
+    if (std::memchr(first, '.', static_cast<std::size_t>(last - first)) == nullptr)
+        throw boost::bad_lexical_cast();
+
+    return numericCast<T>(parseFloating(first, last));
 }
 
 template <typename TResult, typename TInput,
     std::enable_if_t<std::is_arithmetic<TResult>::value && std::is_arithmetic<TInput>::value>*>
 TResult validateRange(TInput value, const struct RangeInterval<TResult>& range)
 {
-    TResult result = boost::numeric_cast<TResult>(value);
+    TResult result = numericCast<TResult>(value);
 
     if (result < range.min)
     {
@@ -65,12 +165,10 @@ TResult validateRange(const response::Value& value, const struct RangeInterval<T
     switch (value.type())
     {
         case response::Type::Int:
-            return validateRange(boost::numeric_cast<TResult>(value.get<response::IntType>()),
-                range);
+            return validateRange<TResult>(value.get<response::IntType>(), range);
 
         case response::Type::Float:
-            return validateRange(boost::numeric_cast<TResult>(value.get<response::FloatType>()),
-                range);
+            return validateRange<TResult>(value.get<response::FloatType>(), range);
 
         case response::Type::String:
             return validateRange(value.get<response::StringType>(), range);
@@ -80,6 +178,102 @@ TResult validateRange(const response::Value& value, const struct RangeInterval<T
     }
 }
 
+template <typename TResult, typename TInput, std::enable_if_t<isRangeListInput<TResult, TInput>>*>
+std::vector<TResult>
+validateRange(const TInput* values, size_t count, const struct RangeInterval<TResult>& range)
+{
+    std::vector<TResult> result(count);
+    TResult* output = result.data();
+
+    // Branchless loops, so they can be vectorized: the conversion is only done once all values
+    // are known to be representable
+    unsigned invalid = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        invalid |= !isRepresentable<TResult>(values[i]);
+    }
+    if (invalid == 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            output[i] = static_cast<TResult>(values[i]);
+            invalid |= (output[i] < range.min) | (output[i] > range.max);
+        }
+    }
+
+    if (invalid == 0)
+    {
+        return result;
+    }
+
+    // slow path: find the first failure and let validateRange() throw its usual exception
+    for (size_t i = 0; i < count; i++)
+    {
+        try
+        {
+            output[i] = validateRange<TResult>(values[i], range);
+        }
+        catch (const std::exception& ex)
+        {
+            throw ListElementException(i, ex.what());
+        }
+    }
+
+    return result;
+}
+
+template <typename TResult, typename TInput>
+static std::vector<TResult>
+validateRangeOfType(const response::ListType& values, const struct RangeInterval<TResult>& range)
+{
+    std::vector<TInput> numbers;
+    numbers.reserve(values.size());
+    for (const auto& value : values)
+    {
+        numbers.push_back(value.get<TInput>());
+    }
+    return validateRange<TResult>(numbers.data(), numbers.size(), range);
+}
+
+template <typename TResult, std::enable_if_t<std::is_arithmetic<TResult>::value>*>
+std::vector<TResult>
+validateRange(const response::ListType& values, const struct RangeInterval<TResult>& range)
+{
+    // list arguments usually have a single element type, check them all at once
+    if (!values.empty())
+    {
+        const auto type = values.front().type();
+        const bool sameType =
+            std::all_of(values.cbegin(), values.cend(), [type](const response::Value& value) {
+                return value.type() == type;
+            });
+        if (sameType && type == response::Type::Int)
+        {
+            return validateRangeOfType<TResult, response::IntType>(values, range);
+        }
+        if (sameType && type == response::Type::Float)
+        {
+            return validateRangeOfType<TResult, response::FloatType>(values, range);
+        }
+    }
+
+    std::vector<TResult> result;
+    result.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        try
+        {
+            result.push_back(validateRange<TResult>(values[i], range));
+        }
+        catch (const std::exception& ex)
+        {
+            throw ListElementException(i, ex.what());
+        }
+    }
+
+    return result;
+}
+
 template <typename TResult, typename TValue, std::enable_if_t<std::is_arithmetic<TResult>::value>*>
 std::optional<TResult>
 validateRange(const std::optional<TValue>& value, const struct RangeInterval<TResult>& range)
@@ -249,6 +443,97 @@ validateRange<double, response::Value>(
 template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::optional<float> validateRange<float, response::Value>(
     const std::optional<response::Value>& value, const struct RangeInterval<float>& range);
 
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int64_t> validateRange<int64_t, int64_t>(
+    const int64_t* values, size_t count, const struct RangeInterval<int64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint64_t> validateRange<uint64_t, uint64_t>(
+    const uint64_t* values, size_t count, const struct RangeInterval<uint64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int32_t> validateRange<int32_t, int32_t>(
+    const int32_t* values, size_t count, const struct RangeInterval<int32_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint32_t> validateRange<uint32_t, uint32_t>(
+    const uint32_t* values, size_t count, const struct RangeInterval<uint32_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int16_t> validateRange<int16_t, int16_t>(
+    const int16_t* values, size_t count, const struct RangeInterval<int16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint16_t> validateRange<uint16_t, uint16_t>(
+    const uint16_t* values, size_t count, const struct RangeInterval<uint16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int8_t> validateRange<int8_t, int8_t>(
+    const int8_t* values, size_t count, const struct RangeInterval<int8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint8_t> validateRange<uint8_t, uint8_t>(
+    const uint8_t* values, size_t count, const struct RangeInterval<uint8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<double> validateRange<double, double>(
+    const double* values, size_t count, const struct RangeInterval<double>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<float> validateRange<float, float>(
+    const float* values, size_t count, const struct RangeInterval<float>& range);
+
+// response::IntType and response::FloatType lists
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int64_t> validateRange<int64_t, int>(
+    const int* values, size_t count, const struct RangeInterval<int64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint64_t> validateRange<uint64_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint32_t> validateRange<uint32_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint32_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int16_t> validateRange<int16_t, int>(
+    const int* values, size_t count, const struct RangeInterval<int16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint16_t> validateRange<uint16_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int8_t> validateRange<int8_t, int>(
+    const int* values, size_t count, const struct RangeInterval<int8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint8_t> validateRange<uint8_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<double> validateRange<double, int>(
+    const int* values, size_t count, const struct RangeInterval<double>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<float> validateRange<float, int>(
+    const int* values, size_t count, const struct RangeInterval<float>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int64_t> validateRange<int64_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint64_t> validateRange<uint64_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int32_t> validateRange<int32_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int32_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint32_t> validateRange<uint32_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint32_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int16_t> validateRange<int16_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint16_t> validateRange<uint16_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int8_t> validateRange<int8_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint8_t> validateRange<uint8_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<float> validateRange<float, double>(
+    const double* values, size_t count, const struct RangeInterval<float>& range);
+
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int64_t> validateRange<int64_t>(
+    const response::ListType& values, const struct RangeInterval<int64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint64_t> validateRange<uint64_t>(
+    const response::ListType& values, const struct RangeInterval<uint64_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int32_t> validateRange<int32_t>(
+    const response::ListType& values, const struct RangeInterval<int32_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint32_t> validateRange<uint32_t>(
+    const response::ListType& values, const struct RangeInterval<uint32_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int16_t> validateRange<int16_t>(
+    const response::ListType& values, const struct RangeInterval<int16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint16_t> validateRange<uint16_t>(
+    const response::ListType& values, const struct RangeInterval<uint16_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<int8_t> validateRange<int8_t>(
+    const response::ListType& values, const struct RangeInterval<int8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<uint8_t> validateRange<uint8_t>(
+    const response::ListType& values, const struct RangeInterval<uint8_t>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<double> validateRange<double>(
+    const response::ListType& values, const struct RangeInterval<double>& range);
+template GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT std::vector<float> validateRange<float>(
+    const response::ListType& values, const struct RangeInterval<float>& range);
+
+ListElementException::ListElementException(size_t index, const char* reason)
+    : m_index(index)
+    , m_message("Element " + std::to_string(index) + ": " + reason)
+{
+}
+
+const char* ListElementException::what() const noexcept
+{
+    return m_message.c_str();
+}
+
 ColorInputStringException::ColorInputStringException()
 {
 }
@@ -18,7 +18,9 @@
 
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <vector>
 #include <cstdio>
 
 #include "graphql_vss_server_libs-support_export.h"
@@ -50,6 +52,104 @@ template <typename TResult, typename TValue,
 std::optional<TResult>
 validateRange(const std::optional<TValue>& value, const struct RangeInterval<TResult>& range);
 
+// List versions: all elements are converted and checked before the first failure is reported
+// with a ListElementException carrying its index
+//
+// They are only instantiated for elements of the result type, int (GraphQL Int) and double
+// (GraphQL Float)
+template <typename TResult, typename TInput>
+inline constexpr bool isRangeListInput = std::is_arithmetic<TResult>::value
+    && (std::is_same<TInput, TResult>::value || std::is_same<TInput, int>::value
+        || std::is_same<TInput, double>::value);
+
+template <typename TResult, typename TInput,
+    std::enable_if_t<isRangeListInput<TResult, TInput>>* = nullptr>
+std::vector<TResult>
+validateRange(const TInput* values, size_t count, const struct RangeInterval<TResult>& range);
+
+template <typename TResult, typename TInput,
+    std::enable_if_t<std::is_arithmetic<TResult>::value && std::is_arithmetic<TInput>::value>* =
+        nullptr>
+inline std::vector<TResult>
+validateRange(const std::vector<TInput>& values, const struct RangeInterval<TResult>& range)
+{
+    static_assert(isRangeListInput<TResult, TInput>,
+        "List elements must be of the result type, int or double");
+    return validateRange<TResult>(values.data(), values.size(), range);
+}
+
+template <typename TResult, std::enable_if_t<std::is_arithmetic<TResult>::value>* = nullptr>
+std::vector<TResult>
+validateRange(const response::ListType& values, const struct RangeInterval<TResult>& range);
+
+// Compile-time ranges, such as the ones from @range directives, are checked inline so the
+// compiler can fold them. Values failing the check go through the runtime validateRange() to
+// throw the usual exceptions:
+//
+//     static constexpr RangeInterval<uint8_t> seatPosition { 0, 100 };
+//     auto position = validateRange<seatPosition>(value);
+//     auto cell = validateRange<uint16_t, 0, 4200>(value);
+
+// Min <= value <= max, comparing integers of different signedness by value. NaN is never within
+template <typename TInput, typename TBound>
+constexpr bool isWithinRange(TInput value, TBound min, TBound max) noexcept
+{
+    if constexpr (std::is_integral_v<TInput> && std::is_integral_v<TBound>
+        && std::is_signed_v<TInput> != std::is_signed_v<TBound>)
+    {
+        if constexpr (std::is_signed_v<TInput>)
+            return value >= 0 && static_cast<uint64_t>(value) >= min
+                && static_cast<uint64_t>(value) <= max;
+        else
+            return max >= 0 && value <= static_cast<uint64_t>(max)
+                && (min < 0 || value >= static_cast<uint64_t>(min));
+    }
+    else
+    {
+        return value >= min && value <= max;
+    }
+}
+
+template <const auto& Range, typename TInput,
+    std::enable_if_t<std::is_arithmetic<TInput>::value>* = nullptr>
+inline auto validateRange(TInput value)
+{
+    using TResult = decltype(Range.min);
+    static_assert(Range.min <= Range.max, "Empty range");
+
+    if (isWithinRange(value, Range.min, Range.max))
+    {
+        return static_cast<TResult>(value);
+    }
+    return validateRange<TResult>(value, Range);
+}
+
+template <const auto& Range, typename TValue>
+inline auto validateRange(const std::optional<TValue>& value)
+    -> std::optional<decltype(validateRange<Range>(value.value()))>
+{
+    if (!value)
+    {
+        return std::nullopt;
+    }
+
+    return validateRange<Range>(value.value());
+}
+
+template <typename T, T Min, T Max>
+struct ConstantRangeInterval
+{
+    static constexpr RangeInterval<T> value { Min, Max };
+};
+
+template <typename TResult, TResult Min, TResult Max, typename TInput,
+    std::enable_if_t<std::is_integral<TResult>::value && std::is_arithmetic<TInput>::value>* =
+        nullptr>
+inline TResult validateRange(TInput value)
+{
+    return validateRange<ConstantRangeInterval<TResult, Min, Max>::value>(value);
+}
+
 #ifndef SCALARS_HPP_LOCAL_TEMPLATES
 extern template int64_t stringToNumber<int64_t>(const std::string& str);
 extern template uint64_t stringToNumber<uint64_t>(const std::string& str);
@@ -197,8 +297,104 @@ extern template std::optional<double> validateRange<double, response::Value>(
     const std::optional<response::Value>& value, const struct RangeInterval<double>& range);
 extern template std::optional<float> validateRange<float, response::Value>(
     const std::optional<response::Value>& value, const struct RangeInterval<float>& range);
+
+extern template std::vector<int64_t> validateRange<int64_t, int64_t>(
+    const int64_t* values, size_t count, const struct RangeInterval<int64_t>& range);
+extern template std::vector<uint64_t> validateRange<uint64_t, uint64_t>(
+    const uint64_t* values, size_t count, const struct RangeInterval<uint64_t>& range);
+extern template std::vector<int32_t> validateRange<int32_t, int32_t>(
+    const int32_t* values, size_t count, const struct RangeInterval<int32_t>& range);
+extern template std::vector<uint32_t> validateRange<uint32_t, uint32_t>(
+    const uint32_t* values, size_t count, const struct RangeInterval<uint32_t>& range);
+extern template std::vector<int16_t> validateRange<int16_t, int16_t>(
+    const int16_t* values, size_t count, const struct RangeInterval<int16_t>& range);
+extern template std::vector<uint16_t> validateRange<uint16_t, uint16_t>(
+    const uint16_t* values, size_t count, const struct RangeInterval<uint16_t>& range);
+extern template std::vector<int8_t> validateRange<int8_t, int8_t>(
+    const int8_t* values, size_t count, const struct RangeInterval<int8_t>& range);
+extern template std::vector<uint8_t> validateRange<uint8_t, uint8_t>(
+    const uint8_t* values, size_t count, const struct RangeInterval<uint8_t>& range);
+extern template std::vector<double> validateRange<double, double>(
+    const double* values, size_t count, const struct RangeInterval<double>& range);
+extern template std::vector<float> validateRange<float, float>(
+    const float* values, size_t count, const struct RangeInterval<float>& range);
+
+// response::IntType and response::FloatType lists
+extern template std::vector<int64_t> validateRange<int64_t, int>(
+    const int* values, size_t count, const struct RangeInterval<int64_t>& range);
+extern template std::vector<uint64_t> validateRange<uint64_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint64_t>& range);
+extern template std::vector<uint32_t> validateRange<uint32_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint32_t>& range);
+extern template std::vector<int16_t> validateRange<int16_t, int>(
+    const int* values, size_t count, const struct RangeInterval<int16_t>& range);
+extern template std::vector<uint16_t> validateRange<uint16_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint16_t>& range);
+extern template std::vector<int8_t> validateRange<int8_t, int>(
+    const int* values, size_t count, const struct RangeInterval<int8_t>& range);
+extern template std::vector<uint8_t> validateRange<uint8_t, int>(
+    const int* values, size_t count, const struct RangeInterval<uint8_t>& range);
+extern template std::vector<double> validateRange<double, int>(
+    const int* values, size_t count, const struct RangeInterval<double>& range);
+extern template std::vector<float> validateRange<float, int>(
+    const int* values, size_t count, const struct RangeInterval<float>& range);
+extern template std::vector<int64_t> validateRange<int64_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int64_t>& range);
+extern template std::vector<uint64_t> validateRange<uint64_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint64_t>& range);
+extern template std::vector<int32_t> validateRange<int32_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int32_t>& range);
+extern template std::vector<uint32_t> validateRange<uint32_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint32_t>& range);
+extern template std::vector<int16_t> validateRange<int16_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int16_t>& range);
+extern template std::vector<uint16_t> validateRange<uint16_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint16_t>& range);
+extern template std::vector<int8_t> validateRange<int8_t, double>(
+    const double* values, size_t count, const struct RangeInterval<int8_t>& range);
+extern template std::vector<uint8_t> validateRange<uint8_t, double>(
+    const double* values, size_t count, const struct RangeInterval<uint8_t>& range);
+extern template std::vector<float> validateRange<float, double>(
+    const double* values, size_t count, const struct RangeInterval<float>& range);
+
+extern template std::vector<int64_t> validateRange<int64_t>(
+    const response::ListType& values, const struct RangeInterval<int64_t>& range);
+extern template std::vector<uint64_t> validateRange<uint64_t>(
+    const response::ListType& values, const struct RangeInterval<uint64_t>& range);
+extern template std::vector<int32_t> validateRange<int32_t>(
+    const response::ListType& values, const struct RangeInterval<int32_t>& range);
+extern template std::vector<uint32_t> validateRange<uint32_t>(
+    const response::ListType& values, const struct RangeInterval<uint32_t>& range);
+extern template std::vector<int16_t> validateRange<int16_t>(
+    const response::ListType& values, const struct RangeInterval<int16_t>& range);
+extern template std::vector<uint16_t> validateRange<uint16_t>(
+    const response::ListType& values, const struct RangeInterval<uint16_t>& range);
+extern template std::vector<int8_t> validateRange<int8_t>(
+    const response::ListType& values, const struct RangeInterval<int8_t>& range);
+extern template std::vector<uint8_t> validateRange<uint8_t>(
+    const response::ListType& values, const struct RangeInterval<uint8_t>& range);
+extern template std::vector<double> validateRange<double>(
+    const response::ListType& values, const struct RangeInterval<double>& range);
+extern template std::vector<float> validateRange<float>(
+    const response::ListType& values, const struct RangeInterval<float>& range);
 #endif
 
+class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ListElementException : public std::exception
+{
+public:
+    ListElementException(size_t index, const char* reason);
+    const char* what() const noexcept override;
+
+    size_t index() const noexcept
+    {
+        return m_index;
+    }
+
+private:
+    size_t m_index;
+    std::string m_message;
+};
+
 class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ColorInputStringException : public std::exception
 {
 public:
@@ -12,6 +12,7 @@
 
 #include <assert.h>
 #include <sstream>
+#include <stdexcept>
 
 #include "singleton.hpp"
 
@@ -84,12 +85,84 @@ std::ostream& operator<<(std::ostream& out, const BaseSingleton& singleton)
     return out;
 }
 
+SingletonStorage::SingletonStorage()
+    : m_executor(std::make_shared<ThreadPoolExecutor>())
+{
+}
+
+SingletonStorage::SingletonStorage(std::shared_ptr<Executor> executor)
+    : m_executor(std::move(executor))
+{
+}
+
 SingletonStorage::~SingletonStorage()
 {
     dbg("~SingletonStorage " << this << " children=" << m_children.size());
+    // running creations may still use this storage. Queued ones won't start
+    // anymore, they are dropped with the singletons futures by clear() and the
+    // executor (maybe shared with other work) is never waited.
+    m_creations->close();
     clear();
 }
 
+Executor& SingletonStorage::executor() const
+{
+    return *m_executor;
+}
+
+ExecutorMetrics SingletonStorage::executorMetrics() const
+{
+    return m_executor->metrics();
+}
+
+void SingletonStorage::setExecutor(std::shared_ptr<Executor> executor)
+{
+    if (m_creations->pending())
+        throw std::logic_error("SingletonStorage::setExecutor() with pending creations");
+    m_executor = std::move(executor);
+}
+
+void SingletonStorage::CreationState::queue()
+{
+    std::lock_guard guard(m_lock);
+    m_queued++;
+}
+
+void SingletonStorage::CreationState::unqueue()
+{
+    std::lock_guard guard(m_lock);
+    m_queued--;
+}
+
+void SingletonStorage::CreationState::start()
+{
+    std::lock_guard guard(m_lock);
+    if (m_closed)
+        throw std::runtime_error("SingletonStorage destroyed before the creation started");
+    m_queued--;
+    m_running++;
+}
+
+void SingletonStorage::CreationState::finish()
+{
+    std::lock_guard guard(m_lock);
+    if (--m_running == 0)
+        m_finished.notify_all();
+}
+
+bool SingletonStorage::CreationState::pending()
+{
+    std::lock_guard guard(m_lock);
+    return m_queued > 0 || m_running > 0;
+}
+
+void SingletonStorage::CreationState::close()
+{
+    std::unique_lock guard(m_lock);
+    m_closed = true;
+    m_finished.wait(guard, [this] { return m_running == 0; });
+}
+
 void SingletonStorage::dispose(BaseSingleton* singleton)
 {
     dbg("SingletonStorage " << this << " dispose=" << *singleton);
@@ -13,13 +13,16 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <future>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
 #include "debug.hpp"
 #include "demangle.hpp"
+#include "executor.hpp"
 #include "spinlock.hpp"
 
 #include "graphql_vss_server_libs-support_export.h"
@@ -206,6 +209,10 @@ public:
 class SingletonStorage
 {
 public:
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT SingletonStorage();
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT explicit SingletonStorage(
+        std::shared_ptr<Executor> executor);
+
     template <typename ResultValue>
     typename Singleton<ResultValue>::Ref get()
     {
@@ -231,6 +238,36 @@ public:
         return typename Singleton<ResultValue>::Ref(ptr);
     }
 
+    // Use in createFuture() instead of std::async(std::launch::async, ...), the
+    // creation runs in the bounded executor. Whoever waits for the value before the
+    // executor started it will run it in its own thread, so singletons depending on
+    // other singletons can't exhaust the executor.
+    //
+    // The creation is pending from now until it finishes, or until it's dropped
+    // without running because nobody waits for it anymore. Creations that didn't
+    // start when the storage is destroyed fail with std::runtime_error.
+    template <typename Fn, typename... Args>
+    auto async(Fn&& fn, Args&&... args)
+    {
+        return postStealable(executor(),
+            [pending = PendingCreation(m_creations),
+                fn = std::forward<Fn>(fn),
+                args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+                auto running = std::move(pending);
+                running.start();
+                return std::apply(fn, args);
+            });
+    }
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT Executor& executor() const;
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ExecutorMetrics executorMetrics() const;
+
+    // Must be called before any singleton is created, throws std::logic_error
+    // while creations are pending in the current executor.
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void setExecutor(std::shared_ptr<Executor> executor);
+
+    // Waits for the running creations of this storage only, the executor may be
+    // shared with other work. Must not be called from one of these creations.
     GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ~SingletonStorage();
 
     GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void dispose(BaseSingleton* singleton);
@@ -247,6 +284,70 @@ public:
     operator<<(std::ostream& out, const SingletonStorage& storage);
 
 private:
+    // Creations posted by async() may outlive the storage (ie: the future of a
+    // detached singleton), so they share this state instead of using the storage.
+    class CreationState
+    {
+    public:
+        GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void queue();
+        GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void unqueue();
+        // throws std::runtime_error once closed
+        GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void start();
+        GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void finish();
+        GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT bool pending();
+        // rejects new starts and waits for the running creations
+        GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void close();
+
+    private:
+        std::mutex m_lock;
+        std::condition_variable m_finished;
+        size_t m_queued = 0;
+        size_t m_running = 0;
+        bool m_closed = false;
+    };
+
+    // Counts a creation as queued while alive, or as running once started
+    class PendingCreation
+    {
+    public:
+        explicit PendingCreation(const std::shared_ptr<CreationState>& state)
+            : m_state(state)
+        {
+            m_state->queue();
+        }
+
+        PendingCreation(PendingCreation const& other) = delete;
+
+        PendingCreation(PendingCreation&& other)
+            : m_state(std::move(other.m_state))
+            , m_started(other.m_started)
+        {
+        }
+
+        ~PendingCreation()
+        {
+            if (!m_state)
+                return;
+            if (m_started)
+                m_state->finish();
+            else
+                m_state->unqueue();
+        }
+
+        void start()
+        {
+            m_state->start();
+            m_started = true;
+        }
+
+    private:
+        std::shared_ptr<CreationState> m_state;
+        bool m_started = false;
+    };
+
+    std::shared_ptr<Executor> m_executor;
+    std::shared_ptr<CreationState> m_creations = std::make_shared<CreationState>();
+
     std::unordered_map<BaseSingleton::Key, BaseSingleton*> m_children;
     std::mutex m_childrenLock;
 
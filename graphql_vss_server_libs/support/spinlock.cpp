@@ -0,0 +1,91 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#include "spinlock.hpp"
+
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Number of pause iterations before parking. Critical sections protected by
+// SpinLock are usually a handful of instructions, this covers them without
+// paying a syscall, while long ones (signal emission) quickly go to sleep.
+#ifndef SPINLOCK_SPIN_COUNT
+#define SPINLOCK_SPIN_COUNT 128
+#endif
+
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+static inline void parkWhile(std::atomic<uint32_t>& state, uint32_t value)
+{
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                  "futex requires a plain 32-bit word");
+    // spurious wake ups and EAGAIN (value changed) are handled by the caller loop
+    syscall(SYS_futex, &state, FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+    (void)state;
+    (void)value;
+    std::this_thread::yield();
+#endif
+}
+
+void SpinLock::lockContended()
+{
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+    m_contended.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    for (unsigned i = 0; i < SPINLOCK_SPIN_COUNT; i++)
+    {
+        // only read while spinning, avoid bouncing the cache line with writes
+        if (m_state.load(std::memory_order_relaxed) == 0)
+        {
+            uint32_t expected = 0;
+            if (m_state.compare_exchange_weak(expected,
+                                              1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+        cpuRelax();
+    }
+
+    // mark as contended so the owner wakes us up on unlock(). If it was
+    // released in the meantime we own it now (conservatively flagged as 2).
+    while (m_state.exchange(2, std::memory_order_acquire) != 0)
+    {
+        parkWhile(m_state, 2);
+    }
+}
+
+void SpinLock::wakeOne()
+{
+#if defined(__linux__)
+    syscall(SYS_futex, &m_state, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
@@ -12,16 +12,43 @@
 
 #pragma once
 
-#include <thread>
 #include <atomic>
+#include <cstdint>
+
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+#include <chrono>
+#endif
 
 #include "debug.hpp"
 #include "graphql_vss_server_libs-support_export.h"
 
-// SpinLock is compliant with std::lock_guard (BasicLockable)
+// Snapshot of the counters kept by a SpinLock, only filled in when built with
+// GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS (cmake -DLOCK_STATS=ON)
+struct SpinLockStats
+{
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;
+    uint64_t maxHoldNanoseconds = 0;
+};
+
+// SpinLock is compliant with std::lock_guard (BasicLockable and Lockable)
+//
+// The uncontended path is a single compare-and-swap. If the lock is taken, it
+// spins a bounded number of times using the CPU pause instruction and then
+// parks the thread on a futex (Linux) until the owner releases it, so long
+// critical sections (ie: signal emission) won't burn whole cores.
 struct SpinLock
 {
-    std::atomic_flag m_flag = ATOMIC_FLAG_INIT;
+    // 0: unlocked, 1: locked, 2: locked and there may be parked waiters
+    std::atomic<uint32_t> m_state { 0 };
+
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+    std::atomic<uint64_t> m_acquisitions { 0 };
+    std::atomic<uint64_t> m_contended { 0 };
+    std::atomic<uint64_t> m_maxHoldNanoseconds { 0 };
+    // only written and read by the lock owner
+    std::chrono::steady_clock::time_point m_lockedAt;
+#endif
 
 #if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_DEBUG_LOCKS
 #define THE_DEBUG_TARGET m_debug_target
@@ -43,18 +70,93 @@ struct SpinLock
 
     inline void lock()
     {
-        debug_will_lock(m_flag, THE_DEBUG_TARGET);
-        // use a spin lock as contention is very unlikely, thus cheaper than a mutex
-        while (m_flag.test_and_set(std::memory_order_acquire))
-            std::this_thread::yield();
-        debug_did_lock(m_flag, THE_DEBUG_TARGET);
+        debug_will_lock(m_state, THE_DEBUG_TARGET);
+        uint32_t expected = 0;
+        if (!m_state.compare_exchange_strong(expected,
+                                             1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+        {
+            lockContended();
+        }
+        didAcquire();
+        debug_did_lock(m_state, THE_DEBUG_TARGET);
+    }
+
+    inline bool try_lock()
+    {
+        uint32_t expected = 0;
+        if (!m_state.compare_exchange_strong(expected,
+                                             1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+        {
+            return false;
+        }
+        didAcquire();
+        debug_did_lock(m_state, THE_DEBUG_TARGET);
+        return true;
     }
 
     inline void unlock()
     {
-        debug_will_unlock(m_flag, THE_DEBUG_TARGET);
-        m_flag.clear(std::memory_order_release);
-        debug_did_unlock(m_flag, THE_DEBUG_TARGET);
+        debug_will_unlock(m_state, THE_DEBUG_TARGET);
+        willRelease();
+        if (m_state.exchange(0, std::memory_order_release) == 2)
+        {
+            wakeOne();
+        }
+        debug_did_unlock(m_state, THE_DEBUG_TARGET);
+    }
+
+    // Returns zeros unless GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS is enabled
+    inline SpinLockStats stats() const
+    {
+        SpinLockStats s;
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+        s.acquisitions = m_acquisitions.load(std::memory_order_relaxed);
+        s.contended = m_contended.load(std::memory_order_relaxed);
+        s.maxHoldNanoseconds = m_maxHoldNanoseconds.load(std::memory_order_relaxed);
+#endif
+        return s;
+    }
+
+    inline void resetStats()
+    {
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+        m_acquisitions.store(0, std::memory_order_relaxed);
+        m_contended.store(0, std::memory_order_relaxed);
+        m_maxHoldNanoseconds.store(0, std::memory_order_relaxed);
+#endif
+    }
+
+private:
+    // slow paths, out of line to keep lock()/unlock() small enough to inline
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void lockContended();
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void wakeOne();
+
+    inline void didAcquire()
+    {
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+        m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        m_lockedAt = std::chrono::steady_clock::now();
+#endif
+    }
+
+    inline void willRelease()
+    {
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+        const uint64_t held = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - m_lockedAt)
+                                  .count();
+        uint64_t current = m_maxHoldNanoseconds.load(std::memory_order_relaxed);
+        while (held > current
+               && !m_maxHoldNanoseconds.compare_exchange_weak(current,
+                                                              held,
+                                                              std::memory_order_relaxed))
+        {
+        }
+#endif
     }
 
 #undef THE_DEBUG_TARGET
@@ -0,0 +1,92 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include "debug.hpp"
+
+#include "timer.hpp"
+
+TimerService::~TimerService()
+{
+    std::unique_lock lock(m_lock);
+    m_stopping = true;
+    lock.unlock();
+    m_changed.notify_all();
+
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+TimerService& TimerService::shared()
+{
+    static TimerService service;
+    return service;
+}
+
+void TimerService::schedule(Clock::time_point when, Task&& task)
+{
+    std::unique_lock lock(m_lock);
+    if (m_stopping)
+        return;
+
+    m_timers.push(Timer { when, m_sequence++, std::move(task) });
+    if (!m_thread.joinable())
+    {
+        dbg("TimerService " << this << " start thread");
+        m_thread = std::thread(&TimerService::run, this);
+        return;
+    }
+
+    lock.unlock();
+    m_changed.notify_one();
+}
+
+void TimerService::run()
+{
+    std::unique_lock lock(m_lock);
+    while (!m_stopping)
+    {
+        if (m_timers.empty())
+        {
+            m_changed.wait(lock);
+            continue;
+        }
+
+        auto when = m_timers.top().when;
+        if (Clock::now() < when)
+        {
+            m_changed.wait_until(lock, when);
+            continue;
+        }
+
+        // priority_queue::top() is const, the timer is discarded right after
+        Task task = std::move(const_cast<Timer&>(m_timers.top()).task);
+        m_timers.pop();
+        lock.unlock();
+
+        try
+        {
+            task();
+        }
+        catch (const std::exception& ex)
+        {
+            dbg(COLOR_RED "TimerService " << this << " task failed: " << ex.what());
+        }
+        catch (...)
+        {
+            dbg(COLOR_RED "TimerService " << this << " task failed");
+        }
+        task = nullptr; // release captures outside of the lock
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "graphql_vss_server_libs-support_export.h"
+
+// Runs tasks at a given time in a single thread, started on demand.
+// Tasks must be short, they delay the next ones. Pending tasks are dropped
+// when the service is destroyed.
+class GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT TimerService
+{
+public:
+    typedef std::function<void(void)> Task;
+    typedef std::chrono::steady_clock Clock;
+
+    TimerService() = default;
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT ~TimerService();
+
+    TimerService(TimerService const&) = delete;
+    TimerService(TimerService&&) = delete;
+
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT void schedule(Clock::time_point when, Task&& task);
+
+    inline void schedule(Clock::duration delay, Task&& task)
+    {
+        schedule(Clock::now() + delay, std::move(task));
+    }
+
+    // Process-wide service, ie: used by the CommonAPI attributes
+    GRAPHQL_VSS_SERVER_LIBS_SUPPORT_EXPORT static TimerService& shared();
+
+private:
+    struct Timer
+    {
+        Clock::time_point when;
+        uint64_t sequence; // keeps the order of timers scheduled to the same time
+        Task task;
+
+        inline bool operator>(const Timer& other) const
+        {
+            return when > other.when || (when == other.when && sequence > other.sequence);
+        }
+    };
+
+    std::mutex m_lock;
+    std::condition_variable m_changed;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_timers;
+    uint64_t m_sequence = 0;
+    bool m_stopping = false;
+    std::thread m_thread;
+
+    void run();
+};
@@ -0,0 +1,302 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <graphql_vss_server_libs/support/commonapi-mainloop.hpp>
+
+class PipeWatch : public CommonAPI::Watch
+{
+public:
+    int fds[2];
+    pollfd pollFd;
+    std::vector<CommonAPI::DispatchSource*> dependentSources;
+    int dispatched = 0;
+    unsigned int dispatchedEvents = 0;
+
+    PipeWatch()
+    {
+        EXPECT_EQ(pipe(fds), 0);
+        pollFd = { fds[0], POLLIN, 0 };
+    }
+
+    ~PipeWatch()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    void signal()
+    {
+        EXPECT_EQ(write(fds[1], "x", 1), 1);
+    }
+
+    void dispatch(unsigned int eventFlags) override
+    {
+        dispatchedEvents = eventFlags;
+        char c;
+        EXPECT_EQ(read(fds[0], &c, 1), 1);
+        dispatched++;
+    }
+
+    const pollfd& getAssociatedFileDescriptor() override
+    {
+        return pollFd;
+    }
+
+    const std::vector<CommonAPI::DispatchSource*>& getDependentDispatchSources() override
+    {
+        return dependentSources;
+    }
+};
+
+class QueueDispatchSource : public CommonAPI::DispatchSource
+{
+public:
+    int pending = 0;
+    int dispatched = 0;
+
+    bool prepare(int64_t& timeout) override
+    {
+        timeout = -1;
+        return pending > 0;
+    }
+
+    bool check() override
+    {
+        return pending > 0;
+    }
+
+    bool dispatch() override
+    {
+        if (pending > 0)
+        {
+            pending--;
+            dispatched++;
+        }
+        return pending > 0;
+    }
+};
+
+class TickTimeout : public CommonAPI::Timeout
+{
+public:
+    int dispatched = 0;
+
+    bool dispatch() override
+    {
+        dispatched++;
+        return true;
+    }
+
+    int64_t getTimeoutInterval() const override
+    {
+        return 10;
+    }
+
+    int64_t getReadyTime() const override
+    {
+        return 0;
+    }
+};
+
+TEST(test_commonapi_mainloop, dispatch)
+{
+    boost::asio::io_context ioContext;
+    auto mainLoop = CommonAPIAsioMainLoop::create(ioContext);
+    auto& context = *mainLoop->context();
+
+    PipeWatch watch;
+    QueueDispatchSource dependentSource;
+    watch.dependentSources.push_back(&dependentSource);
+    QueueDispatchSource source;
+    TickTimeout timeout;
+
+    context.registerWatch(&watch);
+    context.registerDispatchSource(&source);
+    context.registerTimeoutSource(&timeout);
+
+    watch.signal();
+    dependentSource.pending = 2;
+    source.pending = 3;
+    context.wakeup();
+    ioContext.run_for(std::chrono::milliseconds(55));
+
+    EXPECT_EQ(watch.dispatched, 1);
+    EXPECT_EQ(dependentSource.dispatched, 2);
+    EXPECT_EQ(source.dispatched, 3);
+    EXPECT_GE(timeout.dispatched, 3);
+
+    context.deregisterWatch(&watch);
+    context.deregisterTimeoutSource(&timeout);
+    context.deregisterDispatchSource(&source);
+
+    int timeoutDispatched = timeout.dispatched;
+    watch.signal();
+    ioContext.restart();
+    ioContext.run_for(std::chrono::milliseconds(30));
+
+    EXPECT_EQ(watch.dispatched, 1);
+    EXPECT_EQ(timeout.dispatched, timeoutDispatched);
+    // the file descriptor is still owned by the watch
+    watch.signal();
+}
+
+TEST(test_commonapi_mainloop, ready_events)
+{
+    boost::asio::io_context ioContext;
+    auto mainLoop = CommonAPIAsioMainLoop::create(ioContext);
+    auto& context = *mainLoop->context();
+
+    // the read end of a pipe is never writable, only POLLIN may be ready
+    PipeWatch watch;
+    watch.pollFd.events = POLLIN | POLLOUT;
+    context.registerWatch(&watch);
+
+    watch.signal();
+    ioContext.run_for(std::chrono::milliseconds(20));
+
+    EXPECT_EQ(watch.dispatched, 1);
+    EXPECT_EQ(watch.dispatchedEvents, static_cast<unsigned int>(POLLIN));
+
+    context.deregisterWatch(&watch);
+}
+
+class BlockingTimeout : public TickTimeout
+{
+public:
+    std::function<void()> onDispatch;
+
+    bool dispatch() override
+    {
+        if (onDispatch)
+            onDispatch();
+        return TickTimeout::dispatch();
+    }
+};
+
+TEST(test_commonapi_mainloop, register_while_dispatching)
+{
+    boost::asio::io_context ioContext;
+    auto mainLoop = CommonAPIAsioMainLoop::create(ioContext);
+    auto& context = *mainLoop->context();
+
+    QueueDispatchSource source;
+    BlockingTimeout timeout;
+    std::future_status registered = std::future_status::timeout;
+    std::future_status deregistered = std::future_status::ready;
+    std::future<void> remove;
+    timeout.onDispatch = [&]() {
+        if (remove.valid())
+            return;
+
+        // other threads may change the sources while one is dispatched...
+        auto add = std::async(std::launch::async, [&]() {
+            context.registerDispatchSource(&source);
+        });
+        registered = add.wait_for(std::chrono::seconds(1));
+
+        // ... but removing the dispatched one waits for it to finish
+        remove = std::async(std::launch::async, [&]() {
+            context.deregisterTimeoutSource(&timeout);
+        });
+        deregistered = remove.wait_for(std::chrono::milliseconds(50));
+    };
+    context.registerTimeoutSource(&timeout);
+
+    ioContext.run_for(std::chrono::milliseconds(30));
+    remove.wait();
+
+    EXPECT_EQ(registered, std::future_status::ready);
+    EXPECT_EQ(deregistered, std::future_status::timeout);
+    EXPECT_EQ(timeout.dispatched, 1);
+
+    context.deregisterDispatchSource(&source);
+}
+
+class SlowDispatchSource : public CommonAPI::DispatchSource
+{
+public:
+    std::function<void()> onDispatch;
+    std::atomic<int> pending { 0 };
+    std::atomic<int> dispatched { 0 };
+    std::atomic<int> dispatching { 0 };
+    std::atomic<int> maxDispatching { 0 };
+
+    bool prepare(int64_t& timeout) override
+    {
+        timeout = -1;
+        return pending > 0;
+    }
+
+    bool check() override
+    {
+        return pending > 0;
+    }
+
+    bool dispatch() override
+    {
+        int current = ++dispatching;
+        int max = maxDispatching;
+        while (current > max && !maxDispatching.compare_exchange_weak(max, current))
+        {
+        }
+
+        if (onDispatch)
+            onDispatch();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        dispatched++;
+        pending--;
+
+        dispatching--;
+        return false;
+    }
+};
+
+TEST(test_commonapi_mainloop, dispatch_source_once)
+{
+    boost::asio::io_context ioContext;
+    auto mainLoop = CommonAPIAsioMainLoop::create(ioContext);
+    auto& context = *mainLoop->context();
+
+    SlowDispatchSource source;
+    // wakes another io thread while the source is dispatched
+    source.onDispatch = [&]() {
+        context.wakeup();
+    };
+    source.pending = 4;
+    context.registerDispatchSource(&source);
+
+    auto work = boost::asio::make_work_guard(ioContext);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; i++)
+        threads.emplace_back([&]() {
+            ioContext.run_for(std::chrono::milliseconds(200));
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(source.maxDispatching, 1);
+    EXPECT_EQ(source.dispatched, 4);
+
+    context.deregisterDispatchSource(&source);
+}
@@ -0,0 +1,116 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <graphql_vss_server_libs/support/eventstore.hpp>
+
+struct KeyedEvent
+{
+    std::string code;
+    int count;
+
+    const std::string& key() const
+    {
+        return code;
+    }
+};
+
+struct PredicateEvent
+{
+    std::string code;
+    int count;
+
+    static bool findPredicate(const PredicateEvent& a, const PredicateEvent& b)
+    {
+        return a.code == b.code;
+    }
+};
+
+template <typename TEvent>
+static std::string codes(const typename UniqueEventStore<TEvent>::Snapshot& snapshot)
+{
+    std::string result;
+    for (const auto& event : *snapshot)
+        result += event->code;
+    return result;
+}
+
+TEST(test_eventstore, upsert)
+{
+    static_assert(EventKeyTraits<KeyedEvent>::hasKey);
+    static_assert(!EventKeyTraits<PredicateEvent>::hasKey);
+
+    UniqueEventStore<KeyedEvent> keyed;
+    keyed.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "a", 1 }));
+    keyed.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "b", 1 }));
+    keyed.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "a", 2 }));
+    auto snapshot = keyed.snapshot();
+    EXPECT_EQ(keyed.size(), 2u);
+    // without capacity, events keep the order they first arrived
+    EXPECT_EQ(codes<KeyedEvent>(snapshot), "ab");
+    EXPECT_EQ((*snapshot)[0]->count, 2);
+
+    UniqueEventStore<PredicateEvent> predicate;
+    predicate.upsert(std::make_shared<PredicateEvent>(PredicateEvent { "a", 1 }));
+    predicate.upsert(std::make_shared<PredicateEvent>(PredicateEvent { "b", 1 }));
+    predicate.upsert(std::make_shared<PredicateEvent>(PredicateEvent { "a", 2 }));
+    EXPECT_EQ(codes<PredicateEvent>(predicate.snapshot()), "ab");
+    EXPECT_EQ((*predicate.snapshot())[0]->count, 2);
+}
+
+TEST(test_eventstore, capacity)
+{
+    UniqueEventStore<KeyedEvent> store(2);
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "a", 1 }));
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "b", 1 }));
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "c", 1 }));
+    EXPECT_EQ(codes<KeyedEvent>(store.snapshot()), "bc");
+
+    // updates move to the back, the least recently updated is evicted
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "b", 2 }));
+    EXPECT_EQ(codes<KeyedEvent>(store.snapshot()), "cb");
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "d", 1 }));
+    EXPECT_EQ(codes<KeyedEvent>(store.snapshot()), "bd");
+    EXPECT_EQ(store.size(), 2u);
+
+    // evicted keys are inserted again
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "a", 3 }));
+    EXPECT_EQ(codes<KeyedEvent>(store.snapshot()), "da");
+}
+
+TEST(test_eventstore, snapshot)
+{
+    UniqueEventStore<KeyedEvent> store;
+    auto empty = store.snapshot();
+    EXPECT_TRUE(empty->empty());
+
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "a", 1 }));
+    auto first = store.snapshot();
+    // not rebuilt while unchanged
+    EXPECT_EQ(first, store.snapshot());
+
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "a", 2 }));
+    store.upsert(std::make_shared<KeyedEvent>(KeyedEvent { "b", 1 }));
+    auto second = store.snapshot();
+    EXPECT_NE(first, second);
+
+    // snapshots are immutable
+    EXPECT_TRUE(empty->empty());
+    ASSERT_EQ(first->size(), 1u);
+    EXPECT_EQ((*first)[0]->count, 1);
+    EXPECT_EQ(codes<KeyedEvent>(second), "ab");
+    EXPECT_EQ((*second)[0]->count, 2);
+}
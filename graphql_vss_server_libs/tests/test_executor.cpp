@@ -0,0 +1,78 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <set>
+
+#include <graphql_vss_server_libs/support/executor.hpp>
+
+TEST(test_executor, bounded_threads)
+{
+    constexpr size_t taskCount = 16;
+    ThreadPoolExecutor executor(2);
+    std::mutex lock;
+    std::set<std::thread::id> threadIds;
+
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        executor.post([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            std::lock_guard guard(lock);
+            threadIds.insert(std::this_thread::get_id());
+        });
+    }
+    executor.join();
+
+    EXPECT_LE(threadIds.size(), 2u);
+    EXPECT_EQ(threadIds.count(std::this_thread::get_id()), 0u);
+
+    auto metrics = executor.metrics();
+    EXPECT_EQ(metrics.completedTasks, taskCount);
+    EXPECT_EQ(metrics.queueDepth, 0u);
+    EXPECT_EQ(metrics.activeTasks, 0u);
+    EXPECT_GE(metrics.maxQueueDepth, taskCount - 2);
+}
+
+TEST(test_executor, task_exception)
+{
+    ThreadPoolExecutor executor(1);
+    executor.post([] { throw std::runtime_error("failed"); });
+    std::atomic<bool> ran = false;
+    executor.post([&] { ran = true; });
+    executor.join();
+    EXPECT_TRUE(ran);
+}
+
+TEST(test_executor, stealable)
+{
+    ThreadPoolExecutor executor(1);
+    std::promise<void> release;
+    auto blocker = release.get_future().share();
+    executor.post([blocker] { blocker.wait(); });
+
+    // the executor is busy, the waiter runs it
+    auto future = postStealable(executor, [] { return std::this_thread::get_id(); });
+    EXPECT_EQ(future.get(), std::this_thread::get_id());
+
+    release.set_value();
+    executor.join();
+}
+
+TEST(test_executor, stealable_exception)
+{
+    ThreadPoolExecutor executor(1);
+    auto future = postStealable(executor, []() -> int { throw std::runtime_error("failed"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+    executor.join();
+}
@@ -0,0 +1,150 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+
+#include <graphqlservice/GraphQLParse.h>
+
+#include <graphql_vss_server_libs/protocol/fieldpermissions.hpp>
+
+// not dense, checked one by one
+static const ClientPermissions::Key VIN_PERMISSION = PermissionMask::CAPACITY + 10;
+
+class FieldPermissionsTest : public ::testing::Test
+{
+protected:
+    FieldPermissions fieldPermissions;
+
+    void SetUp() override
+    {
+        fieldPermissions.add("Query", "vehicle", { "Vehicle", { 1 } });
+        fieldPermissions.add("Vehicle", "speed", { "", { 2 } });
+        fieldPermissions.add("Vehicle", "vin", { "", { VIN_PERMISSION } });
+        fieldPermissions.add("Vehicle", "cabin", { "Cabin", {} });
+        fieldPermissions.add("Cabin", "door", { "", { 3 } });
+        fieldPermissions.add("Mutation", "setSpeed", { "", { 4 } });
+        fieldPermissions.add("Subscription", "speed", { "", { 5 } });
+    }
+
+    FieldPermissions::Requirements collect(
+        const char* query, const std::string_view& operationName = std::string_view())
+    {
+        auto ast = peg::parseString(query);
+        return fieldPermissions.collect(ast, operationName);
+    }
+
+    static bool isSatisfiedBy(const FieldPermissions::PermissionSet& permissionSet,
+        std::initializer_list<ClientPermissions::Key> keys)
+    {
+        ClientPermissions permissions;
+        for (const auto& key : keys)
+            permissions.insert(key);
+        return permissionSet.isSatisfiedBy(permissions);
+    }
+};
+
+TEST_F(FieldPermissionsTest, required)
+{
+    auto requirements = collect("{ vehicle { speed cabin { door } } }");
+    EXPECT_TRUE(requirements.complete);
+    EXPECT_TRUE(isSatisfiedBy(requirements.required, { 1, 2, 3 }));
+    EXPECT_FALSE(isSatisfiedBy(requirements.required, { 1, 2 }));
+    EXPECT_TRUE(isSatisfiedBy(requirements.conditional, {}));
+}
+
+TEST_F(FieldPermissionsTest, skip_include)
+{
+    auto requirements = collect("query($withCabin: Boolean!) {"
+                                "  vehicle {"
+                                "    speed"
+                                "    cabin @include(if: $withCabin) { door }"
+                                "    ... @skip(if: true) { vin }"
+                                "  }"
+                                "}");
+    EXPECT_TRUE(requirements.complete);
+    EXPECT_TRUE(isSatisfiedBy(requirements.required, { 1, 2 }));
+    EXPECT_FALSE(isSatisfiedBy(requirements.conditional, {}));
+    EXPECT_FALSE(isSatisfiedBy(requirements.conditional, { 3 }));
+    EXPECT_TRUE(isSatisfiedBy(requirements.conditional, { 3, VIN_PERMISSION }));
+}
+
+TEST_F(FieldPermissionsTest, fragments)
+{
+    auto requirements = collect("{ vehicle { ...Info ... on Vehicle { cabin { door } } } }"
+                                "fragment Info on Vehicle { speed vin }");
+    EXPECT_TRUE(requirements.complete);
+    EXPECT_TRUE(isSatisfiedBy(requirements.required, { 1, 2, 3, VIN_PERMISSION }));
+    EXPECT_FALSE(isSatisfiedBy(requirements.required, { 1, 2, 3 }));
+    EXPECT_TRUE(isSatisfiedBy(requirements.conditional, {}));
+}
+
+TEST_F(FieldPermissionsTest, conditional_fragment_spread_again)
+{
+    // the second spread is always resolved, even if the first one was conditional
+    auto requirements = collect("{ vehicle { ...Info @include(if: false) ...Info } }"
+                                "fragment Info on Vehicle { speed }");
+    EXPECT_TRUE(requirements.complete);
+    EXPECT_FALSE(isSatisfiedBy(requirements.required, { 1 }));
+    EXPECT_TRUE(isSatisfiedBy(requirements.required, { 1, 2 }));
+}
+
+TEST_F(FieldPermissionsTest, fragment_cycle)
+{
+    auto requirements = collect("{ vehicle { ...A } }"
+                                "fragment A on Vehicle { speed ...B }"
+                                "fragment B on Vehicle { vin ...A }");
+    EXPECT_FALSE(requirements.complete);
+    EXPECT_FALSE(isSatisfiedBy(requirements.required, { 1, 2 }));
+    EXPECT_TRUE(isSatisfiedBy(requirements.required, { 1, 2, VIN_PERMISSION }));
+}
+
+TEST_F(FieldPermissionsTest, unknown)
+{
+    EXPECT_FALSE(collect("{ vehicle { ...Missing } }").complete);
+    EXPECT_FALSE(collect("{ vehicle { speed odometer } }").complete);
+    EXPECT_FALSE(collect("{ vehicle { speed } }", "Missing").complete);
+}
+
+TEST_F(FieldPermissionsTest, introspection)
+{
+    auto requirements = collect("{ __typename __schema { types { name } } vehicle { __typename } }");
+    EXPECT_TRUE(requirements.complete);
+    EXPECT_TRUE(isSatisfiedBy(requirements.required, { 1 }));
+    EXPECT_FALSE(isSatisfiedBy(requirements.required, {}));
+
+    EXPECT_TRUE(isSatisfiedBy(collect("{ __type(name: \"Vehicle\") { name } }").required, {}));
+}
+
+TEST_F(FieldPermissionsTest, operations)
+{
+    const char* query = "query Q { vehicle { speed } }"
+                        "mutation M { setSpeed }"
+                        "subscription S { speed }";
+
+    auto mutation = collect(query, "M");
+    EXPECT_TRUE(mutation.complete);
+    EXPECT_TRUE(isSatisfiedBy(mutation.required, { 4 }));
+    EXPECT_FALSE(isSatisfiedBy(mutation.required, { 1, 2 }));
+
+    auto subscription = collect(query, "S");
+    EXPECT_TRUE(subscription.complete);
+    EXPECT_TRUE(isSatisfiedBy(subscription.required, { 5 }));
+    EXPECT_FALSE(isSatisfiedBy(subscription.required, { 2 }));
+
+    // without a name the first operation is used
+    auto first = collect(query);
+    EXPECT_TRUE(first.complete);
+    EXPECT_TRUE(isSatisfiedBy(first.required, { 1, 2 }));
+    EXPECT_FALSE(isSatisfiedBy(first.required, { 4 }));
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <graphql_vss_server_libs/support/mempool.hpp>
+
+struct SomeEvent
+{
+    int value;
+    std::string name;
+
+    SomeEvent(int _value, std::string _name)
+        : value(_value)
+        , name(std::move(_name))
+    {
+    }
+};
+
+TEST(test_mempool, recycle)
+{
+    auto pool = std::make_shared<MemoryPool>(4);
+    PoolAllocator<SomeEvent> allocator(pool);
+
+    auto first = std::allocate_shared<SomeEvent>(allocator, 1, "first");
+    const void* firstAddress = first.get();
+    auto reader = first;
+    first.reset();
+    EXPECT_EQ(pool->stats().freeBlocks, 0u); // still referenced
+    reader.reset();
+    EXPECT_EQ(pool->stats().freeBlocks, 1u);
+
+    auto second = std::allocate_shared<SomeEvent>(allocator, 2, "second");
+    EXPECT_EQ(second.get(), firstAddress);
+    EXPECT_EQ(second->value, 2);
+    EXPECT_EQ(second->name, "second");
+
+    auto stats = pool->stats();
+    EXPECT_EQ(stats.allocations, 2u);
+    EXPECT_EQ(stats.recycled, 1u);
+    EXPECT_EQ(stats.freeBlocks, 0u);
+}
+
+TEST(test_mempool, max_free_blocks)
+{
+    auto pool = std::make_shared<MemoryPool>(2);
+    PoolAllocator<SomeEvent> allocator(pool);
+
+    std::vector<std::shared_ptr<SomeEvent>> events;
+    for (int i = 0; i < 5; i++)
+        events.push_back(std::allocate_shared<SomeEvent>(allocator, i, "event"));
+    events.clear();
+
+    EXPECT_EQ(pool->stats().freeBlocks, 2u);
+}
+
+TEST(test_mempool, outlives_pool_owner)
+{
+    std::weak_ptr<MemoryPool> weakPool;
+    std::shared_ptr<SomeEvent> event;
+    {
+        auto pool = std::make_shared<MemoryPool>(2);
+        weakPool = pool;
+        event = std::allocate_shared<SomeEvent>(PoolAllocator<SomeEvent>(pool), 1, "event");
+    }
+    // the control block keeps the pool alive
+    EXPECT_FALSE(weakPool.expired());
+    EXPECT_EQ(event->value, 1);
+    event.reset();
+    EXPECT_TRUE(weakPool.expired());
+}
+
+TEST(test_mempool, large_blocks)
+{
+    auto pool = std::make_shared<MemoryPool>(2);
+    void* ptr = pool->allocate(MemoryPool::maxBlockSize + 1);
+    pool->deallocate(ptr, MemoryPool::maxBlockSize + 1);
+    EXPECT_EQ(pool->stats().freeBlocks, 0u);
+}
@@ -0,0 +1,150 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <string>
+#include <thread>
+
+#include <graphql_vss_server_libs/support/observers.hpp>
+
+TEST(test_observers, emit)
+{
+    ObserverList<void(const std::string&)> signal;
+    std::string first;
+    std::string second;
+
+    auto firstConnection = signal.connect([&](const std::string& value) { first = value; });
+    signal("a");
+    EXPECT_EQ(first, "a");
+
+    auto secondConnection = signal.connect([&](const std::string& value) { second = value; });
+    EXPECT_EQ(signal.size(), 2u);
+    signal("b");
+    EXPECT_EQ(first, "b");
+    EXPECT_EQ(second, "b");
+
+    firstConnection.disconnect();
+    EXPECT_FALSE(firstConnection.connected());
+    EXPECT_TRUE(secondConnection.connected());
+    EXPECT_EQ(signal.size(), 1u);
+    signal("c");
+    EXPECT_EQ(first, "b");
+    EXPECT_EQ(second, "c");
+}
+
+TEST(test_observers, scoped)
+{
+    ObserverList<void(int)> signal;
+    int calls = 0;
+    {
+        auto connection = signal.connect([&](int) { calls++; });
+        signal(1);
+    }
+    signal(2);
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(signal.empty());
+
+    std::deque<ObserverConnection> connections;
+    for (int i = 0; i < 10; i++)
+        connections.push_back(signal.connect([&](int) { calls++; }));
+    signal(3);
+    EXPECT_EQ(calls, 11);
+    connections.clear();
+    signal(4);
+    EXPECT_EQ(calls, 11);
+}
+
+TEST(test_observers, outlives_list)
+{
+    ObserverConnection connection;
+    {
+        ObserverList<void(int)> signal;
+        connection = signal.connect([](int) {});
+        EXPECT_TRUE(connection.connected());
+    }
+    EXPECT_FALSE(connection.connected());
+    connection.disconnect();
+}
+
+TEST(test_observers, disconnect_while_emitting)
+{
+    ObserverList<void(int)> signal;
+    int calls = 0;
+    ObserverConnection second;
+    auto first = signal.connect([&](int) {
+        calls++;
+        second.disconnect();
+    });
+    second = signal.connect([&](int) { calls++; });
+    signal(1);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(test_observers, concurrent)
+{
+    ObserverList<void(int)> signal;
+    std::atomic<int> calls = 0;
+    auto keep = signal.connect([&](int) { calls++; });
+
+    std::atomic<bool> started = false;
+    std::atomic<bool> done = false;
+    std::thread emitter([&] {
+        while (!done)
+        {
+            signal(0);
+            started = true;
+        }
+    });
+    while (!started)
+        std::this_thread::yield();
+    for (int i = 0; i < 1000; i++)
+        auto connection = signal.connect([](int) {});
+    done = true;
+    emitter.join();
+
+    EXPECT_GT(calls, 0);
+    EXPECT_EQ(signal.size(), 1u);
+}
+
+TEST(test_observers, emission_order)
+{
+    ObserverList<void(int)> signal;
+    std::vector<int> received;
+    auto connection = signal.connect([&](int value) { received.push_back(value); });
+
+    EmissionSequencer emission;
+    SpinLock lock(&emission);
+    int produced = 0;
+    std::deque<std::thread> producers;
+    for (int i = 0; i < 4; i++)
+    {
+        producers.emplace_back([&] {
+            for (int j = 0; j < 1000; j++)
+            {
+                std::unique_lock<SpinLock> guard(lock);
+                int value = produced++;
+                auto ticket = emission.ticket();
+                guard.unlock();
+                emission.emit(ticket, [&] { signal(value); });
+            }
+        });
+    }
+    for (auto& producer : producers)
+        producer.join();
+
+    ASSERT_EQ(received.size(), 4000u);
+    for (int i = 0; i < 4000; i++)
+        EXPECT_EQ(received[i], i);
+}
@@ -37,6 +37,63 @@ TEST(test_permissions, multiple)
     EXPECT_THROW(perms.validate(111, 42), PermissionException);
 }
 
+TEST(test_permissions, containsAll)
+{
+    ClientPermissions perms;
+    setupPerms(perms);
+    EXPECT_TRUE(perms.containsAll(111));
+    EXPECT_TRUE(perms.containsAll(111, 2222, 1234));
+    EXPECT_FALSE(perms.containsAll(111, 42));
+    EXPECT_FALSE(perms.containsAll(42, 111));
+}
+
+TEST(test_permissions, sparse)
+{
+    ClientPermissions perms;
+    setupPerms(perms);
+    perms.insert(PermissionMask::CAPACITY - 1);
+    EXPECT_TRUE(perms.contains(111));
+    EXPECT_TRUE(perms.contains(2222));
+    EXPECT_TRUE(perms.contains(PermissionMask::CAPACITY - 1));
+    EXPECT_FALSE(perms.contains(PermissionMask::CAPACITY));
+    EXPECT_FALSE(perms.contains(112));
+    perms.validate(PermissionMask::CAPACITY - 1, 2222);
+    EXPECT_THROW(perms.validate(2223), PermissionException);
+}
+
+TEST(test_permissions, mask)
+{
+    ClientPermissions perms;
+    setupPerms(perms);
+    perms.insert(0);
+    perms.insert(64);
+
+    static constexpr PermissionMask required(0, 64, 111);
+    static_assert(required.test(64));
+    static_assert(!required.test(65));
+    perms.validate(required);
+    perms.validate(PermissionMask());
+    EXPECT_THROW(perms.validate(PermissionMask(0, 65)), PermissionException);
+    EXPECT_THROW(PermissionMask(PermissionMask::CAPACITY), PermissionException);
+}
+
+TEST(test_permissions, constant)
+{
+    ClientPermissions perms;
+    setupPerms(perms);
+    perms.insert(0);
+    perms.insert(64);
+
+    EXPECT_TRUE((perms.containsAll<0, 64, 111>()));
+    EXPECT_TRUE((perms.containsAll<111, 2222, 1234>()));
+    EXPECT_FALSE((perms.containsAll<0, 65>()));
+    EXPECT_FALSE((perms.containsAll<111, 2223>()));
+    perms.validate<111>();
+    perms.validate<0, 2222, 64>();
+    EXPECT_THROW(perms.validate<42>(), PermissionException);
+    EXPECT_THROW((perms.validate<111, 4321>()), PermissionException);
+}
+
 int main(int argc, char** argv)
 {
     std::cerr << std::boolalpha;
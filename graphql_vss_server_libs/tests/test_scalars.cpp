@@ -53,6 +53,23 @@ TEST(StringToNumber, LimitsTest)
     EXPECT_THROW(stringToNumber<uint64_t>(UINT64_INVALID_MAX_VALUE_STR), boost::bad_lexical_cast);
 }
 
+TEST(StringToNumber, ParsingTest)
+{
+    EXPECT_EQ(stringToNumber<int32_t>("+5"), 5);
+    EXPECT_EQ(stringToNumber<int32_t>("-5"), -5);
+    EXPECT_EQ(stringToNumber<int32_t>("-5.9"), -5);
+    EXPECT_EQ(stringToNumber<uint8_t>("255.9"), 255);
+    EXPECT_DOUBLE_EQ(stringToNumber<double>("-.25"), -0.25);
+    EXPECT_THROW(stringToNumber<int32_t>("5a"), boost::bad_lexical_cast);
+    EXPECT_THROW(stringToNumber<int32_t>("1e3"), boost::bad_lexical_cast);
+    EXPECT_THROW(stringToNumber<int32_t>(" 5"), boost::bad_lexical_cast);
+    EXPECT_THROW(stringToNumber<int32_t>("+-5"), boost::bad_lexical_cast);
+    EXPECT_THROW(stringToNumber<int8_t>("128"), boost::numeric::positive_overflow);
+    EXPECT_THROW(stringToNumber<int8_t>("-129"), boost::numeric::negative_overflow);
+    EXPECT_THROW(stringToNumber<uint8_t>("256.0"), boost::numeric::positive_overflow);
+    EXPECT_THROW(stringToNumber<float>("1.0e39"), boost::numeric::positive_overflow);
+}
+
 TEST(ValidateRange, RangeTest)
 {
     EXPECT_NO_THROW(validateRange<int32_t>(0, {}));
@@ -86,6 +103,68 @@ TEST(ValidateRange, Int8CastingTest)
     EXPECT_NO_THROW(validateRange<int8_t>(stringValue, {}));
 }
 
+TEST(ValidateRange, ListTest)
+{
+    std::vector<int32_t> cells = { 0, 3, 4, 100 };
+    EXPECT_EQ(validateRange<uint8_t>(cells, { 0, 100 }), std::vector<uint8_t>({ 0, 3, 4, 100 }));
+    EXPECT_TRUE(validateRange<int32_t>(std::vector<int32_t>(), {}).empty());
+
+    try
+    {
+        cells[2] = 101;
+        cells[3] = 102;
+        [[maybe_unused]] auto _ = validateRange<uint8_t>(cells, { 0, 100 });
+        FAIL() << "out of range element not reported";
+    }
+    catch (const ListElementException& ex)
+    {
+        EXPECT_EQ(ex.index(), 2u);
+    }
+
+    std::vector<double> positions = { 0.5, -1.0, 300.0 };
+    EXPECT_EQ(validateRange<int16_t>(positions, {}), std::vector<int16_t>({ 0, -1, 300 }));
+    positions[1] = -1e10;
+    EXPECT_THROW(validateRange<int16_t>(positions, {}), ListElementException);
+
+    response::ListType values;
+    values.emplace_back(1);
+    values.emplace_back(2);
+    EXPECT_EQ(validateRange<int8_t>(values, { 0, 2 }), std::vector<int8_t>({ 1, 2 }));
+    values.emplace_back(0.5);
+    values.emplace_back(response::Value("3"));
+    EXPECT_EQ(validateRange<float>(values, {}), std::vector<float>({ 1, 2, 0.5, 3 }));
+    try
+    {
+        [[maybe_unused]] auto _ = validateRange<int8_t>(values, { 0, 2 });
+        FAIL() << "out of range element not reported";
+    }
+    catch (const ListElementException& ex)
+    {
+        EXPECT_EQ(ex.index(), 3u);
+    }
+}
+
+static constexpr RangeInterval<uint8_t> seatPosition { 0, 100 };
+static constexpr RangeInterval<float> temperature { -40.5, 85 };
+
+TEST(ValidateRange, ConstantRangeTest)
+{
+    EXPECT_EQ(validateRange<seatPosition>(0), 0);
+    EXPECT_EQ(validateRange<seatPosition>(100.5), 100);
+    EXPECT_THROW(validateRange<seatPosition>(101), std::out_of_range);
+    EXPECT_THROW(validateRange<seatPosition>(-1), boost::numeric::bad_numeric_cast);
+    EXPECT_EQ(validateRange<seatPosition>(-0.5), 0);
+    EXPECT_FLOAT_EQ(validateRange<temperature>(-40.5), -40.5);
+    EXPECT_THROW(validateRange<temperature>(85.5), std::out_of_range);
+    EXPECT_FALSE(validateRange<temperature>(std::optional<double>()).has_value());
+    EXPECT_EQ(validateRange<temperature>(std::optional<double>(1)), 1);
+
+    EXPECT_EQ((validateRange<uint16_t, 0, 4200>(4200)), 4200);
+    EXPECT_THROW((validateRange<uint16_t, 0, 4200>(4201)), std::out_of_range);
+    EXPECT_THROW((validateRange<uint16_t, 0, 4200>(-1)), boost::numeric::bad_numeric_cast);
+    EXPECT_THROW((validateRange<int8_t, -1, 1>(1e10)), boost::numeric::bad_numeric_cast);
+}
+
 TEST(ValidateRange, OptionalValueTest)
 {
     std::optional<int32_t> optionalInt;
@@ -48,9 +48,9 @@ public:
         return std::make_shared<SomeType>(on_stack);
     }
 
-    static std::future<std::shared_ptr<SomeType>> createFuture(SingletonStorage*)
+    static std::future<std::shared_ptr<SomeType>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::async, create);
+        return storage->async(create);
     }
 
     SomeType(const char* str)
@@ -94,9 +94,9 @@ struct ScalarResult
         return std::make_shared<ScalarResult>();
     }
 
-    static std::future<std::shared_ptr<ScalarResult>> createFuture(SingletonStorage*)
+    static std::future<std::shared_ptr<ScalarResult>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::async, create);
+        return storage->async(create);
     }
 
     ScalarResult()
@@ -127,7 +127,7 @@ public:
 
     static std::future<std::shared_ptr<DependOnSomeType>> createFuture(SingletonStorage* storage)
     {
-        return std::async(std::launch::async, create, storage);
+        return storage->async(create, storage);
     }
 
     DependOnSomeType(Singleton<SomeType>::Ref&& someType)
@@ -155,6 +155,34 @@ private:
     Singleton<SomeType>::Ref m_someType;
 };
 
+// Waits for another singleton while being created
+class WaitSomeType
+{
+public:
+    static std::shared_ptr<WaitSomeType> create(SingletonStorage* storage)
+    {
+        return std::make_shared<WaitSomeType>(storage->get<SomeType>().value()->str());
+    }
+
+    static std::future<std::shared_ptr<WaitSomeType>> createFuture(SingletonStorage* storage)
+    {
+        return storage->async(create, storage);
+    }
+
+    WaitSomeType(const std::string& str)
+        : m_str(str)
+    {
+    }
+
+    const std::string str() const
+    {
+        return this->m_str;
+    }
+
+private:
+    std::string m_str;
+};
+
 TEST(singleton_test, sequential_keeps_string)
 {
     dbg(COLOR_BG_CYAN "# STARTING: SEQUENTIAL TESTS");
@@ -462,6 +490,85 @@ TEST(singleton_test, dependent_type)
     EXPECT_EQ(_live_instances, 0) << "there are _live_instances";
 }
 
+TEST(singleton_test, bounded_executor)
+{
+    dbg(COLOR_BG_MAGENTA "# STARTING: BOUNDED EXECUTOR TESTS");
+
+    // a single thread is busy creating WaitSomeType, SomeType must be stolen by the waiter
+    SingletonStorage storage(std::make_shared<ThreadPoolExecutor>(1));
+
+    do
+    {
+        auto r1 = storage.get<WaitSomeType>();
+        auto result1 = r1.value();
+        EXPECT_EQ(result1->str(), TEST_STR);
+    } while (0);
+
+    storage.executor().join();
+    auto metrics = storage.executorMetrics();
+    EXPECT_EQ(metrics.completedTasks, 2u);
+    EXPECT_EQ(metrics.queueDepth, 0u);
+    EXPECT_EQ(metrics.activeTasks, 0u);
+
+    storage.clear();
+    EXPECT_EQ(_live_instances, 0) << "there are _live_instances";
+}
+
+TEST(singleton_test, shared_executor)
+{
+    dbg(COLOR_BG_MAGENTA "# STARTING: SHARED EXECUTOR TESTS");
+
+    // the executor is shared with unrelated work, which must not block the storage
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    executor->post([released] { released.wait(); });
+
+    do
+    {
+        SingletonStorage storage(executor);
+
+        auto r1 = storage.get<SomeType>();
+        // queued behind the unrelated work, thus still pending
+        EXPECT_THROW(storage.setExecutor(std::make_shared<ThreadPoolExecutor>(1)),
+            std::logic_error);
+
+        // stolen by the waiter
+        EXPECT_EQ(r1.value()->str(), TEST_STR);
+        storage.setExecutor(executor);
+    } while (0);
+
+    release.set_value();
+    executor->join();
+    EXPECT_EQ(_live_instances, 0) << "there are _live_instances";
+}
+
+TEST(singleton_test, destroy_with_queued_creation)
+{
+    dbg(COLOR_BG_MAGENTA "# STARTING: DESTROY WITH QUEUED CREATION TESTS");
+
+    // the only thread is busy with unrelated work and nobody waits for SomeType,
+    // the storage must not wait for the executor to reach it
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    executor->post([released] { released.wait_for(std::chrono::seconds(3)); });
+
+    auto startTime = std::chrono::steady_clock::now();
+    do
+    {
+        SingletonStorage storage(executor);
+        storage.get<SomeType>();
+    } while (0);
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+
+    release.set_value();
+    executor->join();
+    EXPECT_EQ(_live_instances, 0) << "there are _live_instances";
+}
+
 int main(int argc, char **argv)
 {
     std::cerr << std::boolalpha;
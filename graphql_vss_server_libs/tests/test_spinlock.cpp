@@ -0,0 +1,97 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <graphql_vss_server_libs/support/spinlock.hpp>
+
+TEST(test_spinlock, try_lock)
+{
+    SpinLock lock(nullptr);
+    EXPECT_TRUE(lock.try_lock());
+    EXPECT_FALSE(lock.try_lock());
+    lock.unlock();
+    EXPECT_TRUE(lock.try_lock());
+    lock.unlock();
+}
+
+TEST(test_spinlock, mutual_exclusion)
+{
+    constexpr int threadCount = 8;
+    constexpr int iterations = 20000;
+    SpinLock lock(nullptr);
+    int counter = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back([&] {
+            for (int j = 0; j < iterations; j++)
+            {
+                std::lock_guard<SpinLock> guard(lock);
+                counter++;
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(counter, threadCount * iterations);
+}
+
+TEST(test_spinlock, parks_long_holds)
+{
+    SpinLock lock(nullptr);
+    bool released = false;
+
+    lock.lock();
+    std::thread waiter([&] {
+        std::lock_guard<SpinLock> guard(lock);
+        EXPECT_TRUE(released);
+    });
+    // long enough for the waiter to exhaust the spins and park
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    released = true;
+    lock.unlock();
+    waiter.join();
+}
+
+#if GRAPHQL_VSS_SERVER_LIBS_SUPPORT_LOCK_STATS
+TEST(test_spinlock, stats)
+{
+    SpinLock lock(nullptr);
+
+    lock.lock();
+    std::thread waiter([&] { std::lock_guard<SpinLock> guard(lock); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    lock.unlock();
+    waiter.join();
+
+    auto s = lock.stats();
+    EXPECT_EQ(s.acquisitions, 2u);
+    EXPECT_EQ(s.contended, 1u);
+    EXPECT_GE(s.maxHoldNanoseconds, 10000000u);
+
+    lock.resetStats();
+    s = lock.stats();
+    EXPECT_EQ(s.acquisitions, 0u);
+    EXPECT_EQ(s.contended, 0u);
+    EXPECT_EQ(s.maxHoldNanoseconds, 0u);
+}
+#endif
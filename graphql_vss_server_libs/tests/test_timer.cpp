@@ -0,0 +1,67 @@
+// Copyright (C) 2021, Bayerische Motoren Werke Aktiengesellschaft (BMW AG),
+//   Author: Alexander Domin (Alexander.Domin@bmw.de)
+// Copyright (C) 2021, ProFUSION Sistemas e Soluções LTDA,
+//   Author: Gustavo Sverzut Barbieri (barbieri@profusion.mobi)
+//
+// SPDX-License-Identifier: MPL-2.0
+//
+// This Source Code Form is subject to the terms of the
+// Mozilla Public License, v. 2.0. If a copy of the MPL was
+// not distributed with this file, You can obtain one at
+// http://mozilla.org/MPL/2.0/.
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include <graphql_vss_server_libs/support/timer.hpp>
+
+TEST(test_timer, order)
+{
+    TimerService timers;
+    std::mutex lock;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    auto append = [&](int value) {
+        std::lock_guard guard(lock);
+        order.push_back(value);
+    };
+
+    auto now = TimerService::Clock::now();
+    timers.schedule(now + std::chrono::milliseconds(30), [&] {
+        append(3);
+        done.set_value();
+    });
+    timers.schedule(now + std::chrono::milliseconds(10), [&] { append(1); });
+    timers.schedule(now + std::chrono::milliseconds(20), [&] { append(2); });
+    timers.schedule(now + std::chrono::milliseconds(20), [&] { append(22); });
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_GE(TimerService::Clock::now() - now, std::chrono::milliseconds(30));
+
+    std::lock_guard guard(lock);
+    EXPECT_EQ(order, std::vector<int>({ 1, 2, 22, 3 }));
+}
+
+TEST(test_timer, dropped_on_destruction)
+{
+    std::atomic<bool> ran = false;
+    {
+        TimerService timers;
+        timers.schedule(std::chrono::seconds(60), [&] { ran = true; });
+    }
+    EXPECT_FALSE(ran);
+}
+
+TEST(test_timer, task_exception)
+{
+    TimerService timers;
+    std::promise<void> done;
+    timers.schedule(std::chrono::milliseconds(0), [] { throw std::runtime_error("failed"); });
+    timers.schedule(std::chrono::milliseconds(1), [&] { done.set_value(); });
+    EXPECT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}